@@ -1,9 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <windows.h>
 #include <conio.h>
 #include <direct.h>
+#include <io.h>
 #include <stdbool.h>
+#include <emmintrin.h>
 
 // Basic settings for the algorithm
 #define TARGET_FILE "spielfeldtest.txt"
@@ -14,6 +18,11 @@
 #define TRAILING_ZERO 1
 #define BUFFER_SIZE 20
 
+// Parser of the text form, the file is split at line breaks into one chunk per thread, small files are parsed
+// by the calling thread only
+#define PARSER_THREADS_MAX 16
+#define PARSER_CHUNK_MIN (1 << 20)
+
 // Limits for the maze size
 #define MAZE_SIZE_MIN 5
 #define MAZE_SIZE_MAX 50
@@ -23,9 +32,119 @@
 #define EMPTY_SPACE 32
 #define BLOCK 219
 
+// Console viewport, only the window around the robot is drawn and the window moves when the robot comes closer to
+// its border than a quarter of the window. Without delay the clock for the next frame is read every VIEWPORT_CHECK_STEPS steps.
+#define VIEWPORT_STATUS_LINES 2
+#define VIEWPORT_DEFAULT_WIDTH 80
+#define VIEWPORT_DEFAULT_HEIGHT 25
+#define VIEWPORT_FRAME_TIME 33
+#define VIEWPORT_CHECK_STEPS 1024
+#define VIEWPORT_RUN_GAP 4
+#define VIEWPORT_CELL_BYTES 16
+#define VIEWPORT_LINE_BYTES 256
+#define VIEWPORT_DIRTY(row, x) (((row)[(x) >> 6] >> ((x) & 63)) & 1)
+
 // Limit for the maximum steps on marker
 #define LIMIT_STEPS_ON_MARKER 3
 
+// Instrumentation of the hot paths - set to 1 to compile counters and timers in
+#ifndef INSTRUMENTATION
+#define INSTRUMENTATION 0
+#endif
+#define INSTRUMENTATION_FILE "instrumentation.json"
+
+// Settings for the maze generator
+#define GENERATOR_SEED 1
+#define GENERATOR_IO_BUFFER (4 << 20)
+#define GENERATOR_ROOM_MIN 2
+#define GENERATOR_ROOM_MAX 5
+#define GENERATOR_STAIRS 8
+#define PACKED_MAGIC "MZB1"
+#define PACKED_MAGIC_SIZE 4
+
+// Start positions reserved at once by the batch mode
+#define BATCH_CAPACITY 64
+
+// Headless solvers give up after this many steps per cell of the maze
+#define SOLVER_STEP_LIMIT_FACTOR 16
+#define POLICY_BENCH_REPEAT 5
+
+// Path output of the headless solver
+#define SOLVE_DEFAULT_POLICY "DRUL-first-3"
+#define SOLVE_PRINT_ROUTE_MAX 200
+#define PATH_CAPACITY 1024
+#define PATH_MAGIC "MZP1"
+#define PATH_WIDE_MAGIC "MZP2"
+#define PATH_MOVE_BITS 2
+#define PATH_WIDE_MOVE_BITS 4
+
+// Result cache of the headless solver, the oldest entries are removed above the size limit
+#define CACHE_DIRECTORY "mazecache"
+#define CACHE_SIZE_LIMIT (64LL << 20)
+#define CACHE_MAGIC "MZC2"
+#define CACHE_READ_BLOCK (1 << 20)
+#define CACHE_POLICY_NAME 32
+
+// Checkpoints of the headless Tremaux' solve, by default every CHECKPOINT_SECONDS seconds
+#define CHECKPOINT_MAGIC "MZK1"
+#define CHECKPOINT_SECONDS 60
+#define CHECKPOINT_CHECK_STEPS 65536
+
+// Mazes in flight between load, solve and output of the pipeline
+#define PIPELINE_DEPTH 3
+
+// Terrain costs 2 to 9 in the text form, the Dijkstra queue has one bucket per cost
+#define TERRAIN_COST_MAX 9
+#define DIJKSTRA_BUCKETS (TERRAIN_COST_MAX + 1)
+#define DIJKSTRA_UNREACHED 0xFF
+#define DIJKSTRA_SOURCE 4
+
+// Crossroads resolved at once by the on-demand classification before memory is reserved
+#define CROSSROAD_STACK 64
+
+// Grid topologies, the A* queue has one bucket per total of cost and estimate and the estimate is only used up to
+// ASTAR_TARGETS destinations. The Tremaux' solvers keep the marks of all passages of a position in 16 bits.
+#define TOPOLOGY_SOLVER_COUNT 3
+#define TOPOLOGY_UNREACHED 0xFF
+#define TOPOLOGY_SOURCE 0xFE
+#define ASTAR_BUCKETS (TERRAIN_COST_MAX + 2)
+#define ASTAR_TARGETS 16
+#define PASSAGE_MARKS(marks, direction) (((marks) >> ((direction) * 2)) & 3)
+
+// Buildings with several levels, packed with four bits per element. The characters of the text form are sorted into
+// element codes, skipped characters and line breaks. Stairs up lead to stairs down on the level above, elevators to both.
+#define BUILDING_MAGIC "MZB3"
+#define BUILDING_READ_BLOCK (1 << 20)
+#define BUILDING_DIRECTIONS 6
+#define BUILDING_ABOVE 4
+#define BUILDING_BELOW 5
+#define BUILDING_SOLVER_COUNT 2
+#define BUILDING_SKIP 0xFD
+#define BUILDING_NEWLINE 0xFE
+#define BUILDING_INVALID 0xFF
+#define BUILDING_UP_CODES ((1 << BuildingStairsUp) | (1 << BuildingElevator))
+#define BUILDING_DOWN_CODES ((1 << BuildingStairsDown) | (1 << BuildingElevator))
+#define BUILDING_CODE(maze, cell) (((maze)->cells[(cell) >> 1] >> (((cell) & 1) * 4)) & 15)
+
+// Differential check of all solvers, a solver fails when it is slower than the baseline by more than the threshold
+// in percent plus the slack in milliseconds
+#define VERIFY_WIDTH 401
+#define VERIFY_HEIGHT 301
+#define VERIFY_COUNT 12
+#define VERIFY_THRESHOLD 25
+#define VERIFY_TIME_SLACK 0.5
+#define VERIFY_TERRAIN_PERCENT 30
+#define VERIFY_REASON_SIZE 160
+#define VERIFY_MAZE_FILE "verify.maze.txt"
+#define VERIFY_TEXT_FILE "verify.spaced.txt"
+#define VERIFY_CHECKPOINT_FILE "verify.checkpoint"
+#define VERIFY_PARSER_CHECKS 2
+#define VERIFY_BUILDING_FILE "verify.building.txt"
+#define VERIFY_PACKED_FILE "verify.building.mzb"
+#define VERIFY_BUILDING_SIZE 41
+#define VERIFY_BUILDING_CHECKS (3 + BUILDING_SOLVER_COUNT)
+#define VERIFY_BASELINE_FILE "verify-%s.baseline"
+
 // fonts color
 #define FBLACK      "\033[30;"
 #define FCYAN       "\x1b[36m"
@@ -52,35 +171,550 @@ typedef enum mazeType
 	Marker
 }mazeType;
 
-// Base structure for all elements from the maze content
+// Base structure for all elements from the maze content, cost is the terrain cost to enter the element.
+// classified is set as soon as type and cost are known, the crossroad bits are only used by the on-demand mode.
 typedef struct
 {
 	mazeType type;
 	bool markOne;
 	bool markTwo;
+	unsigned char cost;
+	unsigned char classified : 1;
+	unsigned char crossroadChecked : 1;
+	unsigned char crossroad : 1;
+	unsigned char onWay : 1;
 }element;
 
+// Window of the maze in the console, origin is the maze position of the upper left corner. Every cell of the window
+// has one bit in dirty, each row starts with a new word. Only cells with a set bit are drawn with the next frame.
+typedef struct
+{
+	HANDLE console;
+	element** elementField;
+	char** field;
+	COORD dimension;
+	COORD origin;
+	COORD size;
+	COORD robot;
+	bool follow;
+	bool isOnDemand;
+	bool repaintAll;
+	int rowWords;
+	unsigned long long* dirty;
+	char* frame;
+	size_t frameSize;
+	unsigned long long lastFrame;
+	long long pendingSteps;
+	long long steps;
+	long long stepsBack;
+}viewport;
+
+// Part of the text form which is parsed by one thread, every chunk starts behind a line break.
+// errorRow is the first row which does not match the header, errorWidth is -1 for a row below the last row.
+typedef struct
+{
+	const unsigned char* begin;
+	const unsigned char* end;
+	char** field;
+	COORD dimension;
+	long long firstRow;
+	long long rowCount;
+	long long errorRow;
+	int errorWidth;
+}parserChunk;
+
+// Where the generator places the destination
+typedef enum destinationPlacement
+{
+	DestinationCorner,
+	DestinationCenter,
+	DestinationRandom
+}destinationPlacement;
+
+// Options for a generated maze, width and height are the size of the written matrix
+typedef struct
+{
+	long long width;
+	long long height;
+	unsigned long long seed;
+	int loopPercent;
+	int roomPercent;
+	destinationPlacement destination;
+	bool binary;
+	int levels;
+	int stairs;
+}generatorSettings;
+
+// Target of the generator, rows are collected in a block before they are written
+typedef struct
+{
+	FILE* file;
+	unsigned char* block;
+	long long blockSize;
+	long long blockUsed;
+	long long rowSize;
+	long long width;
+	bool binary;
+	int levels;
+}generatorOutput;
+
+#if INSTRUMENTATION
+#include <intrin.h>
+
+// Phases of one solve which are timed separately
+typedef enum instrPhase
+{
+	PhaseLoad,
+	PhaseClassify,
+	PhaseSolve,
+	PhasePath,
+	PhaseCount
+}instrPhase;
+
+// Counters and timers collected around the hot paths
+typedef struct
+{
+	unsigned long long steps;
+	unsigned long long firstRuleCalls;
+	unsigned long long secondRuleCalls;
+	unsigned long long directionDown;
+	unsigned long long directionRight;
+	unsigned long long directionUp;
+	unsigned long long directionLeft;
+	unsigned long long markOneTags;
+	unsigned long long markTwoTags;
+	unsigned long long wayBackSteps;
+	long long phaseTicks[PhaseCount];
+	unsigned long long phaseCycles[PhaseCount];
+	long long phaseStartTicks[PhaseCount];
+	unsigned long long phaseStartCycles[PhaseCount];
+}instrumentation;
+
+static instrumentation instr = { 0 };
+
+void instrPhaseBegin(instrPhase phase);
+void instrPhaseEnd(instrPhase phase);
+void instrCountDirection(COORD currentCoord, COORD nextCoord);
+void exportInstrumentation(char fileName[]);
+
+#define INSTR_COUNT(counter)				(instr.counter++)
+#define INSTR_DIRECTION(current, next)		instrCountDirection(current, next)
+#define INSTR_PHASE_BEGIN(phase)			instrPhaseBegin(phase)
+#define INSTR_PHASE_END(phase)				instrPhaseEnd(phase)
+#define INSTR_EXPORT()						exportInstrumentation(INSTRUMENTATION_FILE)
+#else
+// Compiled out - the hot paths stay exactly as without instrumentation
+#define INSTR_COUNT(counter)
+#define INSTR_DIRECTION(current, next)
+#define INSTR_PHASE_BEGIN(phase)
+#define INSTR_PHASE_END(phase)
+#define INSTR_EXPORT()
+#endif
+
+// Steps in the ranking Down, Right, Up, Left
+static const COORD directionOffsets[4] = { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 } };
+static const char directionLetters[4] = { 'D', 'R', 'U', 'L' };
+static const int directionOpposite[4] = { 2, 3, 0, 1 };
+
+// Way from source to destination, every step is the index of its direction packed with moveBits bits.
+// The four directions of directionOffsets need PATH_MOVE_BITS, the grid topologies and buildings PATH_WIDE_MOVE_BITS,
+// moveBits comes first, so a way is created with { PATH_MOVE_BITS } or { PATH_WIDE_MOVE_BITS }.
+typedef struct
+{
+	int moveBits;
+	COORD start;
+	long long length;
+	long long capacity;
+	unsigned char* moves;
+}packedPath;
+
+// Result of a solver without console output
+typedef enum solveStatus
+{
+	SolveFound,
+	SolveNoSolution,
+	SolveStepLimit,
+	SolveNoWayBack
+}solveStatus;
+
+static const char* solveStatusNames[4] = { "found", "no solution", "step limit", "no way back" };
+
+typedef struct
+{
+	solveStatus status;
+	long long steps;
+	long long stepsBack;
+	long long cost;
+	COORD destination;
+}solveResult;
+
+// Checkpoint of a headless Tremaux' solve. The tags markOne and markTwo are kept in two bitplanes with one bit per
+// element while solving, so writing the checkpoint costs no pass over the maze content. The checkpoint is written
+// again when the steps reach nextSteps, with an interval of time this is only when the clock is read.
+typedef struct
+{
+	char* fileName;
+	unsigned long long fileHash;
+	const char* policyName;
+	long long planeWords;
+	unsigned long long* planes[2];
+	long long stepInterval;
+	unsigned long long timeInterval;
+	long long nextSteps;
+	unsigned long long nextTime;
+	bool isResumed;
+	COORD currentCoord;
+	COORD latestCoord;
+	long long steps;
+	int writeCount;
+	double writeMilliseconds;
+}solveCheckpoint;
+
+// Entry of the registry with all instantiated solver policies, optimal solvers always find the cheapest way.
+// solve needs the content of getMazeContent(), solveOnDemand the one of getMazeContentOnDemand().
+typedef solveResult(*policySolver)(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint);
+
+typedef struct
+{
+	const char* name;
+	policySolver solve;
+	policySolver solveOnDemand;
+	bool isOptimal;
+}solverPolicy;
+
+// Diagonal steps between two walls: never, when one of both sides is open, or always
+typedef enum cornerCutting
+{
+	CornerCutNever,
+	CornerCutOneOpen,
+	CornerCutAlways
+}cornerCutting;
+
+// Entry of the registry with all grid topologies, every topology has a Tremaux', a breadth-first and an A* solver
+typedef solveResult(*topologySolver)(char** field, COORD dimension, COORD startPosition, packedPath* path);
+typedef bool(*topologyStep)(char** field, COORD dimension, COORD coord, int direction, COORD* nextCoord);
+
+typedef struct
+{
+	const char* name;
+	const char* const* moveNames;
+	topologyStep step;
+	topologySolver solvers[TOPOLOGY_SOLVER_COUNT];
+}topologyMode;
+
+static const char* topologySolverNames[TOPOLOGY_SOLVER_COUNT] = { "tremaux", "bfs", "astar" };
+
+// Steps of the square grids in the ranking Down, Right, Up, Left and the diagonals, hex rows are shifted by half an element
+static const char* squareMoveNames[8] = { "D", "R", "U", "L", "DR", "UR", "UL", "DL" };
+static const char* hexMoveNames[6] = { "DR", "R", "UR", "UL", "L", "DL" };
+
+// Elements of a building with four bits, BuildingTerrain has the cost 2 and the seven codes after it the costs 3 to 9
+typedef enum buildingElement
+{
+	BuildingCorridor,
+	BuildingWall,
+	BuildingDestination,
+	BuildingStairsUp,
+	BuildingStairsDown,
+	BuildingElevator,
+	BuildingTerrain
+}buildingElement;
+
+static const unsigned char buildingCosts[16] = { 1, 0, 1, 1, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0 };
+
+// Maze with several levels, the elements are packed level by level and row by row with two elements per byte.
+// Every row ends with at least one wall, every level with a row of walls and there is a level of walls below and above,
+// so every neighbour is a fixed offset of the index without checking the borders.
+typedef struct
+{
+	int width;
+	int height;
+	int levels;
+	long long stride;
+	long long levelSize;
+	long long cellCount;
+	long long offsets[6];
+	unsigned char* cells;
+}building;
+
+typedef struct
+{
+	int X;
+	int Y;
+	int Z;
+}buildingCoord;
+
+typedef solveResult(*buildingSolver)(building* maze, buildingCoord startPosition, packedPath* path, buildingCoord* destination);
+
+// Steps in the ranking Down, Right, Up, Left, to the level above and to the level below
+static const char* buildingMoveNames[6] = { "D", "R", "U", "L", "A", "B" };
+static const int buildingOpposite[6] = { 2, 3, 0, 1, 5, 4 };
+
+// Fixed part of a cache entry, the packed way follows directly
+typedef struct
+{
+	char magic[PACKED_MAGIC_SIZE];
+	unsigned int start[2];
+	unsigned int status;
+	unsigned long long fileHash;
+	long long steps;
+	long long stepsBack;
+	long long cost;
+	unsigned long long length;
+	unsigned int destination[2];
+	char policy[CACHE_POLICY_NAME];
+}cacheHeader;
+
+// Header of a checkpoint file, followed by the bitplanes of markOne and markTwo
+typedef struct
+{
+	char magic[PACKED_MAGIC_SIZE];
+	char policy[CACHE_POLICY_NAME];
+	unsigned long long fileHash;
+	int dimension[2];
+	int start[2];
+	int current[2];
+	int latest[2];
+	long long steps;
+}checkpointHeader;
+
+// Entry in the cache directory, collected for the eviction
+typedef struct
+{
+	char name[FILENAME_MAX];
+	unsigned long long lastUse;
+	long long size;
+}cacheFile;
+
+// Bucket of the Dijkstra queue with all cells of the same cost
+typedef struct
+{
+	long long* cells;
+	long long count;
+	long long capacity;
+}costBucket;
+
+// One maze in the pipeline, the stages pass the slots on in the order of the list
+typedef struct
+{
+	char mazeName[FILENAME_MAX];
+	COORD startPosition;
+	COORD dimension;
+	char** field;
+	element** mazeContent;
+	packedPath path;
+	solveResult result;
+	const char* error;
+	bool isLast;
+}pipelineSlot;
+
+// Load, solve and output stages connected by a bounded ring of slots
+typedef struct
+{
+	FILE* list;
+	int policy;
+	bool isExported;
+	bool isOnDemand;
+	pipelineSlot slots[PIPELINE_DEPTH];
+	HANDLE freeSlots;
+	HANDLE loadedSlots;
+	HANDLE solvedSlots;
+	long long loadTicks;
+	long long solveTicks;
+	long long writeTicks;
+	int mazeCount;
+	int failureCount;
+}pipeline;
+
 // Helper function
 char* getFieldByCurrentWorkingDirectory(char fileName[]);
 COORD getDimension(char string[]);
 char** scanFieldFromPath(char* pathToField, COORD* dimension);
-void printMaze2Console(element** markField, COORD dimension);
+char** scanFieldFromText(char* pathToField, COORD* dimension, int chunkCount);
+void runParserThreads(parserChunk* chunks, int chunkCount, LPTHREAD_START_ROUTINE routine);
+DWORD WINAPI countTextRows(LPVOID parameter);
+DWORD WINAPI parseTextRows(LPVOID parameter);
+int parseTextRow(const unsigned char* line, long long length, char* row, int width);
+void printMaze2Console(viewport* view);
 bool validateInput(char** field, COORD dimension, COORD startPosition);
 void printObject2Console(HANDLE hConsole, COORD coord, char object[], char colorFont[], char colorBack[]);
 element** getMazeContent(COORD dimension, char** field);
 
+// Console viewport which only repaints changed cells
+int runWatch(int argc, char* argv[]);
+viewport* createViewport(HANDLE hConsole, element** elementField, char** field, COORD dimension, bool follow, bool isOnDemand, COORD origin);
+void freeViewport(viewport* view);
+SHORT clampViewportOrigin(int origin, SHORT size, SHORT dimension);
+void markViewportCell(viewport* view, COORD coord);
+void moveViewportRobot(viewport* view, COORD coord);
+void followViewport(viewport* view, COORD coord);
+const char* getViewportCell(viewport* view, COORD coord, char* character);
+void drawViewport(viewport* view, bool force);
+void printViewportStatus(viewport* view, char text[]);
+
+// On-demand classification of the maze content
+element** getMazeContentOnDemand(COORD dimension);
+void classifyNeighbours(element** elementField, char** field, COORD dimension, COORD coord);
+void classifyElement(element** elementField, char** field, COORD dimension, COORD coord);
+bool isCrossroad(element** elementField, char** field, COORD dimension, COORD coord);
+bool isJunction(char** field, COORD dimension, COORD coord);
+
 // Maze solving algorithm
 void startMazeSolver(char* path, COORD startPosition, int speed);
-void tremaux(HANDLE hConsole, element** fieldContent, COORD dimension, COORD startPosition, int speed);
+void tremaux(viewport* view, COORD startPosition, int speed);
 COORD firstRule(element** markField, COORD currentCoord, COORD latestCoord);
 COORD secondRule(element** markField, COORD currentCoord);
 
 // Get shortes way back 
 COORD getNextStepBack(element** markField, COORD currentCoord, COORD latestCoord);
-int getWayBack(HANDLE hConsole, element** markField, COORD startPosition, COORD mazeDesination, int speed);
+int getWayBack(viewport* view, COORD startPosition, COORD mazeDesination, int speed);
+
+// Maze generator (Eller's algorithm)
+int runGenerator(int argc, char* argv[]);
+unsigned long long nextRandom(unsigned long long* state);
+bool generateMaze(char* pathToField, generatorSettings settings);
+void writeGeneratedRow(generatorOutput* output, char* elements);
+bool isPackedMaze(char* pathToField);
+char** scanFieldFromPackedPath(char* pathToField, COORD* dimension);
+
+// Batch mode for many start positions in one maze
+int runBatch(int argc, char* argv[]);
+int* solveBatch(char** field, COORD dimension, COORD* starts, int agentCount, int* steps);
+int getBatchDirection(int* distances, COORD dimension, COORD currentCoord);
+
+// Cheapest way on weighted terrain
+solveResult dijkstra(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint);
+void pushCostBucket(costBucket* bucket, long long cell);
+bool isPassable(char character);
+unsigned char getTerrainCost(char character);
+
+// Solver policies with compile-time direction ranking, tie-breaking and marker limit
+int runPolicies(int argc, char* argv[]);
+void resetMazeContent(element** elementField, COORD dimension);
+
+// Headless solve with path output and export of the solved maze
+int runSolve(int argc, char* argv[]);
+bool validateStartPosition(char** field, COORD dimension, COORD startPosition);
+int findSolverPolicy(char* name);
+int getDirection(COORD currentCoord, COORD nextCoord);
+void appendPathMove(packedPath* path, int direction);
+int getPathMove(packedPath* path, long long index);
+void setPathMove(packedPath* path, long long index, int direction);
+void reversePath(packedPath* path, COORD startPosition, const int* opposite);
+long long getPathBytes(packedPath* path, long long length);
+char* encodePathRunLength(packedPath* path, const char* const* moveNames);
+bool exportPath(char* fileName, packedPath* path, const char* const* moveNames);
+bool exportSolvedMaze(char* fileName, element** elementField, char** field, COORD dimension, packedPath* path);
+void printSolveResult(const char* policyName, solveResult result, packedPath* path);
+
+// Checkpoints of long headless solves
+solveCheckpoint* createCheckpoint(char* fileName, unsigned long long fileHash, const char* policyName, COORD dimension, long long stepInterval, unsigned long long timeInterval);
+void freeCheckpoint(solveCheckpoint* checkpoint);
+void markCheckpoint(solveCheckpoint* checkpoint, int plane, COORD dimension, COORD coord);
+void saveCheckpoint(solveCheckpoint* checkpoint, COORD dimension, COORD startPosition, COORD currentCoord, COORD latestCoord, long long steps);
+bool writeCheckpoint(solveCheckpoint* checkpoint, COORD dimension, COORD startPosition);
+bool readCheckpoint(solveCheckpoint* checkpoint, element** elementField, COORD dimension, COORD startPosition);
+
+// Content-addressed result cache of the headless solve
+bool hashMazeFile(char* pathToField, unsigned long long* fileHash);
+unsigned long long mixHash(unsigned long long hash, unsigned long long value);
+void getCacheEntryName(char* entryName, char* cacheDirectory, unsigned long long fileHash, COORD startPosition, const char* policyName);
+bool readCacheEntry(char* entryName, unsigned long long fileHash, COORD startPosition, const char* policyName, solveResult* result, packedPath* path);
+bool writeCacheEntry(char* entryName, char* cacheDirectory, unsigned long long fileHash, COORD startPosition, const char* policyName, solveResult result, packedPath* path);
+void evictCacheEntries(char* cacheDirectory, long long sizeLimit);
+int compareCacheFiles(const void* first, const void* second);
+
+// Pipeline for many mazes with a reader and a writer thread around the solve
+int runPipeline(int argc, char* argv[]);
+DWORD WINAPI pipelineReader(LPVOID parameter);
+DWORD WINAPI pipelineWriter(LPVOID parameter);
+
+// Grid topologies with diagonal steps or hexagonal elements
+int runTopology(int argc, char* argv[]);
+int findTopologyMode(char* name);
+int verifyTopologies(char** field, COORD dimension, COORD startPosition, long long referenceCost, unsigned long long seed);
+
+// Mazes with several levels connected by stairs and elevators
+int runBuilding(int argc, char* argv[]);
+building* createBuilding(int width, int height, int levels);
+void freeBuilding(building* maze);
+long long getBuildingCell(building* maze, buildingCoord coord);
+buildingCoord getBuildingCoord(building* maze, long long cell);
+bool isBuildingStep(building* maze, long long cell, int direction, long long* nextCell);
+building* scanBuildingFromPath(char* pathToBuilding);
+bool finishBuildingRow(building* maze, buildingCoord* coord, unsigned char pending);
+building* scanBuildingFromPackedFile(FILE* file);
+solveResult tremauxBuilding(building* maze, buildingCoord startPosition, packedPath* path, buildingCoord* destination);
+solveResult dijkstraBuilding(building* maze, buildingCoord startPosition, packedPath* path, buildingCoord* destination);
+
+// Differential correctness and performance check of all solvers
+int runVerify(int argc, char* argv[]);
+void addTerrainCosts(char** field, COORD dimension, unsigned long long seed);
+long long getReferenceCost(char** field, COORD dimension, COORD startPosition);
+bool checkSolvedPath(char** field, COORD dimension, COORD startPosition, solveResult result, packedPath* path, topologyStep step, const char* const* moveNames, char* reason);
+bool readVerifyBaseline(char* fileName, double baseline[][2]);
+bool writeVerifyBaseline(char* fileName, double baseline[][2]);
+int verifyTextParser(char* pathToField, COORD dimension, unsigned long long seed);
+bool verifyResume(element** mazeContent, char** field, COORD dimension, COORD startPosition, int policy, solveResult reference, packedPath* referencePath, char* reason);
+int verifyBuilding(unsigned long long seed, int variant);
+bool checkBuildingPath(building* maze, buildingCoord startPosition, solveResult result, packedPath* path, char* reason);
 
 int main(int argc, char* argv[])
 {
+	// Generate a new maze into a file instead of solving one
+	if (argc > 1 && strcmp(argv[1], "generate") == 0)
+	{
+		exit(runGenerator(argc, argv));
+	}
+
+	// Solve the maze for many start positions at once
+	if (argc > 1 && strcmp(argv[1], "batch") == 0)
+	{
+		exit(runBatch(argc, argv));
+	}
+
+	// Compare all solver policies on one maze
+	if (argc > 1 && strcmp(argv[1], "policies") == 0)
+	{
+		exit(runPolicies(argc, argv));
+	}
+
+	// Solve without console output and export the results
+	if (argc > 1 && strcmp(argv[1], "solve") == 0)
+	{
+		exit(runSolve(argc, argv));
+	}
+
+	// Solve a list of mazes with overlapping load, solve and output
+	if (argc > 1 && strcmp(argv[1], "pipeline") == 0)
+	{
+		exit(runPipeline(argc, argv));
+	}
+
+	// Solve with diagonal steps or on hexagonal elements
+	if (argc > 1 && strcmp(argv[1], "topology") == 0)
+	{
+		exit(runTopology(argc, argv));
+	}
+
+	// Solve a maze with several levels
+	if (argc > 1 && strcmp(argv[1], "building") == 0)
+	{
+		exit(runBuilding(argc, argv));
+	}
+
+	// Watch the solver on mazes larger than the console
+	if (argc > 1 && strcmp(argv[1], "watch") == 0)
+	{
+		exit(runWatch(argc, argv));
+	}
+
+	// Check all solvers on random mazes against a reference and the timing baseline
+	if (argc > 1 && strcmp(argv[1], "verify") == 0)
+	{
+		exit(runVerify(argc, argv));
+	}
+
 	// Enter your settings
 	char* path2TargetFile = getFieldByCurrentWorkingDirectory(TARGET_FILE);
 	int speed = SPEED_STANDARD;
@@ -111,7 +745,9 @@ void startMazeSolver(char* path, COORD startPosition, int speed)
 	COORD dimension = { 0 };
 
 	// Get field from selected path and calculate dimension
+	INSTR_PHASE_BEGIN(PhaseLoad);
 	char** field = scanFieldFromPath(path, &dimension);
+	INSTR_PHASE_END(PhaseLoad);
 
 	if (field != NULL)
 	{
@@ -123,10 +759,9 @@ void startMazeSolver(char* path, COORD startPosition, int speed)
 		}
 
 		// Create a mirrow field with all marker elements
+		INSTR_PHASE_BEGIN(PhaseClassify);
 		element** mazeContent = getMazeContent(dimension, field);
-
-		// Print the field to console
-		printMaze2Console(mazeContent, dimension);
+		INSTR_PHASE_END(PhaseClassify);
 
 		if (mazeContent == NULL)
 		{
@@ -134,8 +769,18 @@ void startMazeSolver(char* path, COORD startPosition, int speed)
 			exit(1);
 		}
 
+		// Print the window around the start position to console
+		COORD origin = { 0 };
+		viewport* view = createViewport(hConsole, mazeContent, field, dimension, TRUE, FALSE, origin);
+		followViewport(view, startPosition);
+		printMaze2Console(view);
+
 		// Start the algorithm to solve the maze
-		tremaux(hConsole, mazeContent, dimension, startPosition, speed);
+		tremaux(view, startPosition, speed);
+		freeViewport(view);
+
+		// Write the collected counters and timers
+		INSTR_EXPORT();
 
 		// Free the memory for the field
 		for (int index = 0; index < dimension.Y; index++)
@@ -203,7 +848,7 @@ char* getFieldByCurrentWorkingDirectory(char fileName[])
 }
 
 /// <summary>
-/// Trim the dimension of the maze from the string
+/// Trim the dimension of the maze from the string, a value outside of 0 to SHRT_MAX does not fit into COORD and gives 0
 /// </summary>
 /// <param name="string">that is to be split</param>
 /// <returns>Dimension of the maze in coordination</returns>
@@ -221,14 +866,17 @@ COORD getDimension(char string[])
 	// Split the X coordination from the string
 	ptr = strtok_s(string, delimiter, &nextToken);
 
-	if (ptr != NULL)
-		coord.X = atoi(ptr);
+	long long value = ptr != NULL ? atoll(ptr) : 0;
+
+	if (value > 0 && value <= SHRT_MAX)
+		coord.X = (SHORT)value;
 
 	// Split the Y coordination from the string
 	ptr = strtok_s(NULL, delimiter, &nextToken);
+	value = ptr != NULL ? atoll(ptr) : 0;
 
-	if (ptr != NULL)
-		coord.Y = atoi(ptr);
+	if (value > 0 && value <= SHRT_MAX)
+		coord.Y = (SHORT)value;
 
 	return coord;
 }
@@ -244,769 +892,6200 @@ char** scanFieldFromPath(char* pathToField, COORD* dimension)
 	if (pathToField == NULL)
 		return NULL;
 
-	FILE* file;
-	errno_t errNo = fopen_s(&file, pathToField, "r");
+	// Mazes from the generator can also be packed with two bits per element
+	if (isPackedMaze(pathToField))
+		return scanFieldFromPackedPath(pathToField, dimension);
 
-	// When can not opened the file then exit
-	if (errNo != 0)
+	return scanFieldFromText(pathToField, dimension, 0);
+}
+
+/// <summary>
+/// Read the text form with several threads. The file is mapped into memory and split at line breaks into one chunk
+/// per thread, the first pass counts the rows of every chunk and the second pass parses the rows into the field.
+/// </summary>
+/// <param name="pathToField">for the target .txt</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="chunkCount">count of chunks up to PARSER_THREADS_MAX, 0 for one chunk per processor and PARSER_CHUNK_MIN</param>
+/// <returns>Field with all elements - returns NULL when a row does not match the header</returns>
+char** scanFieldFromText(char* pathToField, COORD* dimension, int chunkCount)
+{
+	HANDLE file = CreateFileA(pathToField, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER fileSize = { 0 };
+
+	// A missing or empty file is reported to the caller, so a batch of mazes goes on with the next one
+	if (file == INVALID_HANDLE_VALUE || GetFileSizeEx(file, &fileSize) != TRUE || fileSize.QuadPart == 0)
 	{
-		printf("Error! - this file can not be open\n");
-		exit(1);
+		printf("Error! - %s can not be open or is empty\n", pathToField);
+
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+
+		return NULL;
 	}
-	else
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	const unsigned char* text = mapping != NULL ? (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+	if (text == NULL)
 	{
-		// Read first line of .txt to get dimension
-		char buffer[BUFFER_SIZE];
-		fgets(buffer, BUFFER_SIZE, file);
+		printf("Error! - %s can not be mapped into memory\n", pathToField);
+
+		if (mapping != NULL)
+			CloseHandle(mapping);
 
-		*dimension = getDimension(buffer);
+		CloseHandle(file);
+		return NULL;
+	}
+
+	// Read first line of .txt to get dimension
+	const unsigned char* textEnd = text + fileSize.QuadPart;
+	const unsigned char* body = (const unsigned char*)memchr(text, '\n', (size_t)fileSize.QuadPart);
+	char buffer[BUFFER_SIZE] = { 0 };
+
+	body = body != NULL ? body + 1 : textEnd;
+	memcpy(buffer, text, body - text < BUFFER_SIZE ? (size_t)(body - text) : BUFFER_SIZE - 1);
+
+	// Buildings with several levels have their own reader
+	int levels = 1;
+	char** field = NULL;
+
+	if (strncmp(buffer, BUILDING_MAGIC, PACKED_MAGIC_SIZE) == 0 || (sscanf_s(buffer, "%*d %*d %d", &levels) == 1 && levels > 1))
+	{
+		printf("Error - %s has several levels, solve it with the building command\n", pathToField);
+	}
+	else if ((*dimension = getDimension(buffer)).X <= 0 || dimension->Y <= 0)
+	{
+		printf("Error - %s has no valid dimension in the first line\n", pathToField);
+	}
+	else
+	{
+		field = (char**)calloc(dimension->Y, sizeof(char*));
 
-		// Create a dynamically array with the dimensions
-		char** field = (char**)calloc(dimension->Y, sizeof(char*));
+		if (field == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
 
 		for (int index = 0; index < dimension->Y; index++)
 		{
 			field[index] = calloc(dimension->X, sizeof(char));
+
+			if (field[index] == NULL)
+			{
+				printf("Error - Failed to reserve memory\n");
+				exit(1);
+			}
 		}
 
-		if (field == NULL)
+		// Small files are parsed by the calling thread only
+		long long bodySize = textEnd - body;
+
+		if (chunkCount <= 0)
 		{
-			printf("Error - Failed to reserve memory\n");
-			exit(1);
+			SYSTEM_INFO systemInfo;
+			GetSystemInfo(&systemInfo);
+
+			chunkCount = bodySize / PARSER_CHUNK_MIN > (long long)systemInfo.dwNumberOfProcessors
+				? (int)systemInfo.dwNumberOfProcessors : (int)(bodySize / PARSER_CHUNK_MIN);
 		}
 
-		int indexX = 0;
-		int indexY = 0;
-		char tempBuffer = 0;
+		if (chunkCount > PARSER_THREADS_MAX)
+			chunkCount = PARSER_THREADS_MAX;
+
+		if (chunkCount < 1)
+			chunkCount = 1;
 
-		// Iterate through file until end of file
-		while ((tempBuffer = fgetc(file)) != EOF)
+		// Every chunk except the first starts behind the next line break
+		parserChunk chunks[PARSER_THREADS_MAX] = { 0 };
+
+		for (int index = 0; index < chunkCount; index++)
 		{
-			if (tempBuffer == '\n')
+			const unsigned char* begin = body + bodySize * index / chunkCount;
+
+			if (index > 0)
 			{
-				indexX = 0;
-				indexY += 1;
+				const unsigned char* lineBreak = (const unsigned char*)memchr(begin - 1, '\n', textEnd - begin + 1);
+				begin = lineBreak != NULL ? lineBreak + 1 : textEnd;
+				chunks[index - 1].end = begin;
 			}
-			else if (tempBuffer != EMPTY_SPACE)
+
+			chunks[index].begin = begin;
+			chunks[index].end = textEnd;
+			chunks[index].field = field;
+			chunks[index].dimension = *dimension;
+		}
+
+		runParserThreads(chunks, chunkCount, countTextRows);
+
+		long long rowCount = 0;
+
+		for (int index = 0; index < chunkCount; index++)
+		{
+			chunks[index].firstRow = rowCount;
+			rowCount += chunks[index].rowCount;
+		}
+
+		runParserThreads(chunks, chunkCount, parseTextRows);
+
+		// The first wrong row of the file is reported
+		for (int index = 0; index < chunkCount && field != NULL; index++)
+		{
+			if (chunks[index].errorRow >= 0 && chunks[index].errorWidth < 0)
+				printf("Error - %s has more rows than the %d of the first line\n", pathToField, dimension->Y);
+			else if (chunks[index].errorRow >= 0)
+				printf("Error - row %lld of %s has %d instead of %d elements\n", chunks[index].errorRow, pathToField, chunks[index].errorWidth, dimension->X);
+			else if (index == chunkCount - 1 && rowCount < dimension->Y)
+				printf("Error - %s has %lld instead of %d rows\n", pathToField, rowCount, dimension->Y);
+			else
+				continue;
+
+			for (int row = 0; row < dimension->Y; row++)
 			{
-				field[indexY][indexX] = tempBuffer;
-				indexX += 1;
+				free(field[row]);
 			}
 
+			free(field);
+			field = NULL;
 		}
-
-		fclose(file);
-		return field;
 	}
+
+	UnmapViewOfFile(text);
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	return field;
 }
 
 /// <summary>
-/// Display the maze to the console, with all diffrent types
+/// Run a pass of the parser on all chunks, the first chunk is parsed by the calling thread
 /// </summary>
-/// <param name="markArray">with the content of the maze</param>
-/// <param name="dimension">the size of the maze</param>
-void printMaze2Console(element** elementField, COORD dimension)
+/// <param name="chunks">parts of the text form</param>
+/// <param name="chunkCount">count of chunks and threads</param>
+/// <param name="routine">pass to run on every chunk</param>
+void runParserThreads(parserChunk* chunks, int chunkCount, LPTHREAD_START_ROUTINE routine)
 {
-	// Function system to use cmd for terminal
-	// cls to clear complete terminal
-	system("cls");
+	HANDLE threads[PARSER_THREADS_MAX] = { 0 };
 
-	// Iterate through the content of the maze
-	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	for (int index = 1; index < chunkCount; index++)
 	{
-		for (int indexX = 0; indexX < dimension.X; indexX++)
-		{
-			if (elementField[indexY][indexX].type == Wall)
-				printf(FBLACK BBLACK"%c"DEFAULT_COLOR, BLOCK);
+		threads[index] = CreateThread(NULL, 0, routine, &chunks[index], 0, NULL);
 
-			if (elementField[indexY][indexX].type == Corridor)
-				printf(FBLACK BWHITE" "DEFAULT_COLOR);
+		// Without a thread of its own the chunk is parsed afterwards
+		if (threads[index] == NULL)
+			routine(&chunks[index]);
+	}
 
-			if (elementField[indexY][indexX].type == Marker)
-				printf(FBLACK BWHITE" "DEFAULT_COLOR);
+	routine(&chunks[0]);
 
-			if (elementField[indexY][indexX].type == Destination)
-				printf(FBLACK BBLUE" "DEFAULT_COLOR);
+	for (int index = 1; index < chunkCount; index++)
+	{
+		if (threads[index] != NULL)
+		{
+			WaitForSingleObject(threads[index], INFINITE);
+			CloseHandle(threads[index]);
 		}
-
-		printf("\n");
 	}
 }
 
 /// <summary>
-/// Validate maze size is between 5x5 and 50x50 and
-/// check start position is not a maze wall or the destination
+/// First pass of the parser: count the line breaks of a chunk 16 bytes at a time
 /// </summary>
-/// <param name="field">- from textdocument</param>
-/// <param name="dimension">- X and Y size of field</param>
-/// <param name="startPosition">- X and Y of start position</param>
-/// <returns>True when all conditions passed</returns>
-bool validateInput(char** field, COORD dimension, COORD startPosition)
+/// <param name="parameter">the chunk</param>
+/// <returns>Exit code of the thread</returns>
+DWORD WINAPI countTextRows(LPVOID parameter)
 {
-	if (field == NULL)
-		return FALSE;
+	parserChunk* chunk = (parserChunk*)parameter;
+	const unsigned char* position = chunk->begin;
+	const __m128i lineBreaks = _mm_set1_epi8('\n');
+	long long rowCount = 0;
 
-	// Validate that the size is in the middle of the limits 
-	if (dimension.Y < MAZE_SIZE_MIN || dimension.X < MAZE_SIZE_MIN)
+	// Every compare gives -1 for a line break, the byte counters are summed up before they can overflow
+	while (chunk->end - position >= 16)
 	{
-		printf("Error - the dimension [ %d | %d ] is to short!\n", dimension.X, dimension.Y);
-		printf("Please try again with a larger maze.\n");
-		exit(1);
-	}
-	if (dimension.Y > MAZE_SIZE_MAX || dimension.X > MAZE_SIZE_MAX)
-	{
-		printf("Fcked the dimension [ %d | %d ] is to large!\n", dimension.X, dimension.Y);
-		printf("Please try again with a smaller maze.\n");
-		exit(1);
-	}
+		__m128i counters = _mm_setzero_si128();
 
-	// Validate that the start position is not inside a wall
-	if (field[startPosition.Y][startPosition.X] == '1')
-	{
-		printf("Error - start position can not be inside a wall!\n");
-		printf("Please try again, with another start position than X:%d Y:%d.\n", startPosition.X, startPosition.Y);
-		exit(1);
+		for (int block = 0; block < 255 && chunk->end - position >= 16; block++, position += 16)
+		{
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)position), lineBreaks));
+		}
+
+		__m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+		rowCount += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
 	}
-	// Validate that the start position is not the maze destination
-	if (field[startPosition.Y][startPosition.X] == 'X')
+
+	for (; position < chunk->end; position++)
 	{
-		printf("Error - start position can not be the maze destination!\n");
-		printf("Please try again, with another start position than X:%d Y:%d.\n", startPosition.X, startPosition.Y);
-		exit(1);
+		rowCount += *position == '\n';
 	}
 
-	return TRUE;
+	// Only the last chunk can end with a row without line break
+	if (chunk->end > chunk->begin && chunk->end[-1] != '\n')
+		rowCount++;
+
+	chunk->rowCount = rowCount;
+	return 0;
 }
 
 /// <summary>
-/// Console display to print located characters with color
+/// Second pass of the parser: copy the elements of every row of a chunk into the field and check the width.
+/// Empty rows below the last row of the header are allowed.
 /// </summary>
-/// <param name="hConsole">target at which to print</param>
-/// <param name="coord">location in console</param>
-/// <param name="object">character to print</param>
-/// <param name="colorFont">font to dye</param>
-/// <param name="colorBack">background to dye</param>
-void printObject2Console(HANDLE hConsole, COORD coord, char object[], char colorFont[], char colorBack[])
+/// <param name="parameter">the chunk</param>
+/// <returns>Exit code of the thread</returns>
+DWORD WINAPI parseTextRows(LPVOID parameter)
 {
-	SetConsoleCursorPosition(hConsole, coord);
+	parserChunk* chunk = (parserChunk*)parameter;
+	const unsigned char* line = chunk->begin;
 
-	printf("%s", colorFont);
-	printf("%s", colorBack);
-	printf("%s", object);
-	printf(DEFAULT_COLOR);
+	chunk->errorRow = -1;
+
+	for (long long row = chunk->firstRow; line < chunk->end; row++)
+	{
+		const unsigned char* lineEnd = (const unsigned char*)memchr(line, '\n', chunk->end - line);
+
+		if (lineEnd == NULL)
+			lineEnd = chunk->end;
+
+		int elementCount = row < chunk->dimension.Y ? parseTextRow(line, lineEnd - line, chunk->field[row], chunk->dimension.X)
+			: parseTextRow(line, lineEnd - line, NULL, 0);
+
+		if (row < chunk->dimension.Y && elementCount != chunk->dimension.X)
+		{
+			chunk->errorRow = row;
+			chunk->errorWidth = elementCount;
+			return 1;
+		}
+
+		if (row >= chunk->dimension.Y && elementCount != 0)
+		{
+			chunk->errorRow = row;
+			chunk->errorWidth = -1;
+			return 1;
+		}
+
+		line = lineEnd + 1;
+	}
+
+	return 0;
 }
 
 /// <summary>
-/// Scan maze from scratch textfile. Mark every start of a corridor when there are more than two branches.
+/// Copy the elements of one row of the text form. In the usual form "1 0 X ..." every second byte is an element,
+/// so 32 bytes hold 16 elements: the odd bytes are compared with spaces and the even bytes are packed into the row.
+/// Rows with other spaces, tabs or "\r\n" are read byte by byte from the first difference, also a tab or a carriage
+/// return at an even byte like in "1 \t 0" is no element.
 /// </summary>
-/// <param name="dimension">of the maze in the form of coordinations</param>
-/// <param name="field">the scratch maze with 0 and 1</param>
-/// <returns></returns>
-element** getMazeContent(COORD dimension, char** field)
+/// <param name="line">first character of the row</param>
+/// <param name="length">of the row without line break</param>
+/// <param name="row">receives the elements, can be NULL to count only</param>
+/// <param name="width">count of elements in the row</param>
+/// <returns>Count of elements - returns width + 1 if there are more elements than the width</returns>
+int parseTextRow(const unsigned char* line, long long length, char* row, int width)
 {
-	// Catch that the field is correct
-	if (field == NULL)
+	const __m128i spaces = _mm_set1_epi8(EMPTY_SPACE);
+	const __m128i tabs = _mm_set1_epi8('\t');
+	const __m128i returns = _mm_set1_epi8('\r');
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	long long offset = 0;
+	int elementCount = 0;
+
+	while (offset + 32 <= length && elementCount + 16 <= width)
 	{
-		return NULL;
+		__m128i first = _mm_loadu_si128((const __m128i*)(line + offset));
+		__m128i second = _mm_loadu_si128((const __m128i*)(line + offset + 16));
+		unsigned int spaceMask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(first, spaces))
+			| ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(second, spaces)) << 16);
+		unsigned int separatorMask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(first, tabs), _mm_cmpeq_epi8(first, returns)))
+			| ((unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(second, tabs), _mm_cmpeq_epi8(second, returns))) << 16);
+
+		// The scalar loop skips all separators, so both paths give the same elements
+		if (spaceMask != 0xAAAAAAAAu || separatorMask != 0)
+			break;
+
+		_mm_storeu_si128((__m128i*)(row + elementCount), _mm_packus_epi16(_mm_and_si128(first, lowBytes), _mm_and_si128(second, lowBytes)));
+		elementCount += 16;
+		offset += 32;
 	}
 
-	// Create dynamically memory for the maze with the dimension
-	element** markArray = (element**)calloc(dimension.Y, sizeof(element*));
-
-	for (int index = 0; index < dimension.Y; index++)
+	for (; offset < length; offset++)
 	{
-		markArray[index] = calloc(dimension.X, sizeof(element));
+		if (line[offset] == EMPTY_SPACE || line[offset] == '\t' || line[offset] == '\r')
+			continue;
+
+		if (elementCount == width)
+			return width + 1;
+
+		row[elementCount++] = line[offset];
 	}
 
-	if (markArray == NULL)
+	return elementCount;
+}
+
+/// <summary>
+/// Create the maze content for the on-demand mode. Nothing is classified yet, the solvers classify every element
+/// the first time they reach it, so the work and the memory touched grow with the visited area instead of the maze.
+/// </summary>
+/// <param name="dimension">of the maze in the form of coordinations</param>
+/// <returns>Maze content where no element is classified</returns>
+element** getMazeContentOnDemand(COORD dimension)
+{
+	// One large block from calloc gets zero pages from the system, which are only touched when an element is classified.
+	// Rows of their own would be cleared one by one, so the block starts at the first row and is freed with it.
+	element** markArray = (element**)calloc(dimension.Y, sizeof(element*));
+	element* elements = (element*)calloc((size_t)dimension.X * dimension.Y, sizeof(element));
+
+	if (markArray == NULL || elements == NULL)
 	{
 		printf("Error! - can not reserve memory for the %dx%d\n", dimension.X, dimension.Y);
 		exit(1);
 	}
 
-	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	for (int index = 0; index < dimension.Y; index++)
 	{
-		for (int indexX = 0; indexX < dimension.X; indexX++)
-		{
+		markArray[index] = elements + (size_t)index * dimension.X;
+	}
+
+	return markArray;
+}
+
+/// <summary>
+/// Classify a position and its four neighbours when this did not happen so far, the solvers call this for every position they reach.
+/// With getMazeContent() all elements are already classified and nothing happens.
+/// </summary>
+/// <param name="elementField">content of the maze</param>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">reached position</param>
+void classifyNeighbours(element** elementField, char** field, COORD dimension, COORD coord)
+{
+	if (elementField[coord.Y][coord.X].classified != TRUE)
+		classifyElement(elementField, field, dimension, coord);
+
+	for (int direction = 0; direction < 4; direction++)
+	{
+		COORD nextCoord = { coord.X + directionOffsets[direction].X, coord.Y + directionOffsets[direction].Y };
+
+		if (nextCoord.X >= 0 && nextCoord.Y >= 0 && nextCoord.X < dimension.X && nextCoord.Y < dimension.Y
+			&& elementField[nextCoord.Y][nextCoord.X].classified != TRUE)
+			classifyElement(elementField, field, dimension, nextCoord);
+	}
+}
+
+/// <summary>
+/// Classify one element like getMazeContent(): a corridor is a marker when one of its neighbours is a crossroad
+/// </summary>
+/// <param name="elementField">content of the maze</param>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">position to classify</param>
+void classifyElement(element** elementField, char** field, COORD dimension, COORD coord)
+{
+	element* content = &elementField[coord.Y][coord.X];
+	char character = field[coord.Y][coord.X];
+
+	content->classified = TRUE;
+	content->cost = getTerrainCost(character);
+
+	if (character == '1')
+	{
+		content->type = Wall;
+		return;
+	}
+
+	if (character == 'X')
+	{
+		content->type = Destination;
+		return;
+	}
+
+	content->type = Corridor;
+
+	for (int direction = 0; direction < 4; direction++)
+	{
+		COORD nextCoord = { coord.X + directionOffsets[direction].X, coord.Y + directionOffsets[direction].Y };
+
+		if (nextCoord.X >= 0 && nextCoord.Y >= 0 && nextCoord.X < dimension.X && nextCoord.Y < dimension.Y
+			&& isCrossroad(elementField, field, dimension, nextCoord))
+		{
+			content->type = Marker;
+			return;
+		}
+	}
+}
+
+/// <summary>
+/// Check if a position is a crossroad which marks its neighbours. getMazeContent() skips junctions which were
+/// already marked by the crossroad above or left of them, so a crossroad depends on these two.
+/// They are resolved with an own stack instead of recursion, in open areas the chain of junctions can be long.
+/// </summary>
+/// <param name="elementField">content of the maze, keeps the result in the crossroad bits</param>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">position to check</param>
+/// <returns>True for a crossroad</returns>
+bool isCrossroad(element** elementField, char** field, COORD dimension, COORD coord)
+{
+	COORD localStack[CROSSROAD_STACK];
+	COORD* stack = localStack;
+	int stackCapacity = CROSSROAD_STACK;
+	int stackCount = 1;
+
+	stack[0] = coord;
+
+	while (stackCount > 0)
+	{
+		COORD currentCoord = stack[stackCount - 1];
+		element* content = &elementField[currentCoord.Y][currentCoord.X];
+
+		if (content->crossroadChecked != TRUE && isJunction(field, dimension, currentCoord) != TRUE)
+		{
+			content->crossroadChecked = TRUE;
+			content->crossroad = FALSE;
+		}
+
+		if (content->crossroadChecked)
+		{
+			stackCount--;
+			continue;
+		}
+
+		// A junction is inside the maze, so both positions exist
+		COORD aboveCoord = { currentCoord.X, currentCoord.Y - 1 };
+		COORD leftCoord = { currentCoord.X - 1, currentCoord.Y };
+		element* above = &elementField[aboveCoord.Y][aboveCoord.X];
+		element* left = &elementField[leftCoord.Y][leftCoord.X];
+
+		if (above->crossroadChecked && left->crossroadChecked)
+		{
+			content->crossroadChecked = TRUE;
+			content->crossroad = above->crossroad != TRUE && left->crossroad != TRUE;
+			stackCount--;
+			continue;
+		}
+
+		if (stackCount == stackCapacity)
+		{
+			stackCapacity *= 2;
+			stack = (COORD*)(stack == localStack ? malloc(stackCapacity * sizeof(COORD)) : realloc(stack, stackCapacity * sizeof(COORD)));
+
+			if (stack == NULL)
+			{
+				printf("Error - Failed to reserve memory\n");
+				exit(1);
+			}
+
+			if (stackCapacity == 2 * CROSSROAD_STACK)
+				memcpy(stack, localStack, sizeof(localStack));
+		}
+
+		stack[stackCount] = above->crossroadChecked ? leftCoord : aboveCoord;
+		stackCount++;
+	}
+
+	if (stack != localStack)
+		free(stack);
+
+	return elementField[coord.Y][coord.X].crossroad;
+}
+
+/// <summary>
+/// Check if a corridor inside the maze has more than two corridors around it
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">position to check</param>
+/// <returns>True for a junction</returns>
+bool isJunction(char** field, COORD dimension, COORD coord)
+{
+	// Destinations are never scanned as junction by getMazeContent()
+	if (coord.X <= 0 || coord.Y <= 0 || coord.X >= dimension.X - 1 || coord.Y >= dimension.Y - 1
+		|| isPassable(field[coord.Y][coord.X]) != TRUE)
+		return FALSE;
+
+	int countCorners = 0;
+
+	for (int direction = 0; direction < 4; direction++)
+	{
+		if (isPassable(field[coord.Y + directionOffsets[direction].Y][coord.X + directionOffsets[direction].X]))
+			countCorners++;
+	}
+
+	return countCorners > 2;
+}
+
+/// <summary>
+/// Display the window of the maze to the console, with all diffrent types
+/// </summary>
+/// <param name="view">window of the maze content</param>
+void printMaze2Console(viewport* view)
+{
+	// Clear the console with an escape sequence, the window is drawn into the visible area of the console
+	printf("\033[2J");
+
+	view->repaintAll = TRUE;
+	drawViewport(view, TRUE);
+}
+
+/// <summary>
+/// Validate maze size is between 5x5 and 50x50 and
+/// check start position is not a maze wall or the destination
+/// </summary>
+/// <param name="field">- from textdocument</param>
+/// <param name="dimension">- X and Y size of field</param>
+/// <param name="startPosition">- X and Y of start position</param>
+/// <returns>True when all conditions passed</returns>
+bool validateInput(char** field, COORD dimension, COORD startPosition)
+{
+	if (field == NULL)
+		return FALSE;
+
+	// Validate that the size is in the middle of the limits 
+	if (dimension.Y < MAZE_SIZE_MIN || dimension.X < MAZE_SIZE_MIN)
+	{
+		printf("Error - the dimension [ %d | %d ] is to short!\n", dimension.X, dimension.Y);
+		printf("Please try again with a larger maze.\n");
+		exit(1);
+	}
+	if (dimension.Y > MAZE_SIZE_MAX || dimension.X > MAZE_SIZE_MAX)
+	{
+		printf("Fcked the dimension [ %d | %d ] is to large!\n", dimension.X, dimension.Y);
+		printf("Please try again with a smaller maze.\n");
+		exit(1);
+	}
+
+	// Validate that the start position is not inside a wall
+	if (field[startPosition.Y][startPosition.X] == '1')
+	{
+		printf("Error - start position can not be inside a wall!\n");
+		printf("Please try again, with another start position than X:%d Y:%d.\n", startPosition.X, startPosition.Y);
+		exit(1);
+	}
+	// Validate that the start position is not the maze destination
+	if (field[startPosition.Y][startPosition.X] == 'X')
+	{
+		printf("Error - start position can not be the maze destination!\n");
+		printf("Please try again, with another start position than X:%d Y:%d.\n", startPosition.X, startPosition.Y);
+		exit(1);
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Console display to print located characters with color
+/// </summary>
+/// <param name="hConsole">target at which to print</param>
+/// <param name="coord">location in console</param>
+/// <param name="object">character to print</param>
+/// <param name="colorFont">font to dye</param>
+/// <param name="colorBack">background to dye</param>
+void printObject2Console(HANDLE hConsole, COORD coord, char object[], char colorFont[], char colorBack[])
+{
+	SetConsoleCursorPosition(hConsole, coord);
+
+	printf("%s", colorFont);
+	printf("%s", colorBack);
+	printf("%s", object);
+	printf(DEFAULT_COLOR);
+}
+
+/// <summary>
+/// Command line to watch the console solver on a maze of any size:
+/// watch <maze> [X Y] [-speed ms] [-view X Y] [-lazy]
+/// The window follows the robot, with -view it stays at this position of the maze.
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when the maze was solved</returns>
+int runWatch(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s watch <maze> [X Y] [-speed ms] [-view X Y] [-lazy]\n", argv[0]);
+		return 1;
+	}
+
+	COORD startPosition = { 1, 1 };
+	COORD origin = { 0 };
+	int speed = 0;
+	bool follow = TRUE;
+	bool isOnDemand = FALSE;
+
+	for (int index = 3; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-speed") == 0 && index + 1 < argc)
+			speed = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-view") == 0 && index + 2 < argc)
+		{
+			origin.X = (SHORT)atoi(argv[++index]);
+			origin.Y = (SHORT)atoi(argv[++index]);
+			follow = FALSE;
+		}
+		else if (strcmp(argv[index], "-lazy") == 0)
+			isOnDemand = TRUE;
+		else if (index + 1 < argc && argv[index][0] != '-')
+		{
+			startPosition.X = (SHORT)atoi(argv[index]);
+			startPosition.Y = (SHORT)atoi(argv[++index]);
+		}
+		else
+		{
+			printf("Error - unknown watch option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	COORD dimension = { 0 };
+	char** field = scanFieldFromPath(argv[2], &dimension);
+
+	if (field == NULL || validateStartPosition(field, dimension, startPosition) != TRUE)
+		return 1;
+
+	element** mazeContent = isOnDemand ? getMazeContentOnDemand(dimension) : getMazeContent(dimension, field);
+	viewport* view = createViewport(GetStdHandle(STD_OUTPUT_HANDLE), mazeContent, field, dimension, follow, isOnDemand, origin);
+
+	if (follow)
+		followViewport(view, startPosition);
+
+	printMaze2Console(view);
+	tremaux(view, startPosition, speed);
+	freeViewport(view);
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		// The on-demand content is one block, which starts at the first row
+		if (isOnDemand != TRUE || index == 0)
+			free(mazeContent[index]);
+
+		free(field[index]);
+	}
+
+	free(mazeContent);
+	free(field);
+
+	return 0;
+}
+
+/// <summary>
+/// Create the window of the maze which is shown in the console. The window is not larger than the visible area of the
+/// console, so nothing scrolls, and all cursor positions are relative to the visible area.
+/// </summary>
+/// <param name="hConsole">target at which to print</param>
+/// <param name="elementField">content of the maze with all types</param>
+/// <param name="field">the scratch maze, shows elements of the on-demand mode which are not classified yet</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="follow">TRUE to move the window with the robot</param>
+/// <param name="isOnDemand">TRUE when elementField is from getMazeContentOnDemand(), so the solver classifies every step</param>
+/// <param name="origin">maze position of the upper left corner of the window</param>
+/// <returns>Window where every cell has to be drawn with the first frame</returns>
+viewport* createViewport(HANDLE hConsole, element** elementField, char** field, COORD dimension, bool follow, bool isOnDemand, COORD origin)
+{
+	int windowWidth = VIEWPORT_DEFAULT_WIDTH;
+	int windowHeight = VIEWPORT_DEFAULT_HEIGHT;
+	CONSOLE_SCREEN_BUFFER_INFO screenInfo;
+	DWORD consoleMode = 0;
+
+	if (GetConsoleScreenBufferInfo(hConsole, &screenInfo))
+	{
+		windowWidth = screenInfo.srWindow.Right - screenInfo.srWindow.Left + 1;
+		windowHeight = screenInfo.srWindow.Bottom - screenInfo.srWindow.Top + 1;
+	}
+
+	// Colors and cursor positions are written as escape sequences
+	if (GetConsoleMode(hConsole, &consoleMode))
+		SetConsoleMode(hConsole, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+	viewport* view = (viewport*)calloc(1, sizeof(viewport));
+
+	if (view == NULL)
+	{
+		printf("Error - Failed to reserve dynamic memory\n");
+		exit(1);
+	}
+
+	view->console = hConsole;
+	view->elementField = elementField;
+	view->field = field;
+	view->dimension = dimension;
+	view->follow = follow;
+	view->isOnDemand = isOnDemand;
+	view->repaintAll = TRUE;
+	view->size.X = (SHORT)(windowWidth < dimension.X ? windowWidth : dimension.X);
+	view->size.Y = (SHORT)(windowHeight - VIEWPORT_STATUS_LINES < dimension.Y ? windowHeight - VIEWPORT_STATUS_LINES : dimension.Y);
+
+	if (view->size.Y < 1)
+		view->size.Y = 1;
+
+	view->origin.X = clampViewportOrigin(origin.X, view->size.X, dimension.X);
+	view->origin.Y = clampViewportOrigin(origin.Y, view->size.Y, dimension.Y);
+	view->robot.X = -1;
+	view->robot.Y = -1;
+
+	// Every drawn cell needs at most a color change and its character, every run of cells a cursor position
+	view->rowWords = (view->size.X + 63) / 64;
+	view->dirty = (unsigned long long*)calloc((size_t)view->rowWords * view->size.Y, sizeof(unsigned long long));
+	view->frameSize = (size_t)view->size.X * view->size.Y * VIEWPORT_CELL_BYTES + (size_t)(view->size.Y + VIEWPORT_STATUS_LINES) * VIEWPORT_LINE_BYTES;
+	view->frame = (char*)malloc(view->frameSize);
+
+	if (view->dirty == NULL || view->frame == NULL)
+	{
+		printf("Error - Failed to reserve dynamic memory\n");
+		exit(1);
+	}
+
+	return view;
+}
+
+/// <summary>
+/// Free the window and its buffers, the maze content stays
+/// </summary>
+/// <param name="view">window to free</param>
+void freeViewport(viewport* view)
+{
+	free(view->dirty);
+	free(view->frame);
+	free(view);
+}
+
+/// <summary>
+/// Keep the window inside the maze
+/// </summary>
+/// <param name="origin">wanted first position of the window</param>
+/// <param name="size">of the window in this direction</param>
+/// <param name="dimension">of the maze in this direction</param>
+/// <returns>First position, so the window does not leave the maze</returns>
+SHORT clampViewportOrigin(int origin, SHORT size, SHORT dimension)
+{
+	if (origin > dimension - size)
+		origin = dimension - size;
+
+	if (origin < 0)
+		origin = 0;
+
+	return (SHORT)origin;
+}
+
+/// <summary>
+/// Draw a cell of the maze again with the next frame, cells outside the window are drawn when the window moves
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="coord">changed position of the maze</param>
+void markViewportCell(viewport* view, COORD coord)
+{
+	int x = coord.X - view->origin.X;
+	int y = coord.Y - view->origin.Y;
+
+	if (x < 0 || y < 0 || x >= view->size.X || y >= view->size.Y)
+		return;
+
+	view->dirty[(size_t)y * view->rowWords + (x >> 6)] |= 1ULL << (x & 63);
+}
+
+/// <summary>
+/// Move the robot to the next position, the old and the new position are drawn again
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="coord">next position of the robot</param>
+void moveViewportRobot(viewport* view, COORD coord)
+{
+	markViewportCell(view, view->robot);
+	view->robot = coord;
+	markViewportCell(view, coord);
+	view->steps++;
+
+	if (view->follow)
+		followViewport(view, coord);
+}
+
+/// <summary>
+/// Center the window at a position, when it comes closer to the border of the window than a quarter of the window
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="coord">position which has to stay visible</param>
+void followViewport(viewport* view, COORD coord)
+{
+	int marginX = view->size.X / 4;
+	int marginY = view->size.Y / 4;
+
+	if (coord.X >= view->origin.X + marginX && coord.X < view->origin.X + view->size.X - marginX
+		&& coord.Y >= view->origin.Y + marginY && coord.Y < view->origin.Y + view->size.Y - marginY)
+		return;
+
+	COORD origin;
+	origin.X = clampViewportOrigin(coord.X - view->size.X / 2, view->size.X, view->dimension.X);
+	origin.Y = clampViewportOrigin(coord.Y - view->size.Y / 2, view->size.Y, view->dimension.Y);
+
+	// At the border of the maze the window can not move any further
+	if (origin.X != view->origin.X || origin.Y != view->origin.Y)
+	{
+		view->origin = origin;
+		view->repaintAll = TRUE;
+	}
+}
+
+/// <summary>
+/// Get the character and the background of a cell like the console solver has drawn it before
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="coord">position of the maze</param>
+/// <param name="character">receives the character to print</param>
+/// <returns>Background color of the cell</returns>
+const char* getViewportCell(viewport* view, COORD coord, char* character)
+{
+	element content = view->elementField[coord.Y][coord.X];
+	mazeType type = content.type;
+
+	*character = ' ';
+
+	if (coord.X == view->robot.X && coord.Y == view->robot.Y)
+	{
+		*character = ROBOTER[0];
+		return BWHITE;
+	}
+
+	if (content.onWay)
+	{
+		*character = 'X';
+		return BGREEN;
+	}
+
+	// Elements of the on-demand mode which are not reached so far are shown from the scratch maze
+	if (content.classified != TRUE)
+		type = view->field[coord.Y][coord.X] == '1' ? Wall : view->field[coord.Y][coord.X] == 'X' ? Destination : Corridor;
+
+	if (type == Wall)
+	{
+		*character = (char)BLOCK;
+		return BBLACK;
+	}
+
+	if (type == Destination)
+		return BBLUE;
+
+	if (type == Marker && content.markTwo)
+		return BRED;
+
+	if (type == Marker && content.markOne)
+		return BYELLOW;
+
+	return BWHITE;
+}
+
+/// <summary>
+/// Draw all changed cells of the window and the status line with one write. Cells next to each other are drawn in one
+/// run, which only needs one cursor position, and the color is only written when it changes.
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="force">FALSE to skip the frame when the last frame is more recent than VIEWPORT_FRAME_TIME</param>
+void drawViewport(viewport* view, bool force)
+{
+	if (force != TRUE)
+	{
+		// Reading the clock every step would cost more than the step itself
+		if (++view->pendingSteps % VIEWPORT_CHECK_STEPS != 0 || GetTickCount64() - view->lastFrame < VIEWPORT_FRAME_TIME)
+			return;
+	}
+
+	char* frame = view->frame;
+	size_t used = 0;
+
+	// A moved window draws every cell
+	if (view->repaintAll)
+	{
+		memset(view->dirty, 0xFF, (size_t)view->rowWords * view->size.Y * sizeof(unsigned long long));
+		view->repaintAll = FALSE;
+	}
+
+	for (int y = 0; y < view->size.Y; y++)
+	{
+		unsigned long long* row = view->dirty + (size_t)y * view->rowWords;
+		int x = 0;
+
+		while (x < view->size.X)
+		{
+			// Skip clean words at once
+			if ((row[x >> 6] >> (x & 63)) == 0)
+			{
+				x = ((x >> 6) + 1) << 6;
+				continue;
+			}
+
+			if (VIEWPORT_DIRTY(row, x) == 0)
+			{
+				x++;
+				continue;
+			}
+
+			// Small gaps are cheaper to draw than a new cursor position
+			int runEnd = x + 1;
+
+			for (int next = runEnd; next < view->size.X && next - runEnd < VIEWPORT_RUN_GAP; next++)
+			{
+				if (VIEWPORT_DIRTY(row, next))
+					runEnd = next + 1;
+			}
+
+			used += snprintf(frame + used, view->frameSize - used, "\033[%d;%dH", y + 1, x + 1);
+			const char* latestColor = NULL;
+
+			for (; x < runEnd; x++)
+			{
+				COORD coord = { (SHORT)(view->origin.X + x), (SHORT)(view->origin.Y + y) };
+				char character;
+				const char* color = getViewportCell(view, coord, &character);
+
+				if (color != latestColor)
+				{
+					used += snprintf(frame + used, view->frameSize - used, FBLACK"%s", color);
+					latestColor = color;
+				}
+
+				frame[used++] = character;
+			}
+		}
+
+		memset(row, 0, view->rowWords * sizeof(unsigned long long));
+	}
+
+	used += snprintf(frame + used, view->frameSize - used,
+		DEFAULT_COLOR"\033[%d;1H\033[K"D_FGREEN BBLACK"Steps %lld  way back %lld  window X:%d Y:%d of %dx%d"DEFAULT_COLOR,
+		view->size.Y + 1, view->steps, view->stepsBack, view->origin.X, view->origin.Y, view->dimension.X, view->dimension.Y);
+
+	fwrite(frame, 1, used, stdout);
+	fflush(stdout);
+	view->lastFrame = GetTickCount64();
+}
+
+/// <summary>
+/// Print a message in the line below the status line of the window
+/// </summary>
+/// <param name="view">window of the maze</param>
+/// <param name="text">message to print</param>
+void printViewportStatus(viewport* view, char text[])
+{
+	printf("\033[%d;1H\033[K"D_FGREEN BBLACK"%s"DEFAULT_COLOR, view->size.Y + VIEWPORT_STATUS_LINES, text);
+	fflush(stdout);
+}
+
+/// <summary>
+/// Scan maze from scratch textfile. Mark every start of a corridor when there are more than two branches.
+/// </summary>
+/// <param name="dimension">of the maze in the form of coordinations</param>
+/// <param name="field">the scratch maze with 0 and 1</param>
+/// <returns></returns>
+element** getMazeContent(COORD dimension, char** field)
+{
+	// Catch that the field is correct
+	if (field == NULL)
+	{
+		return NULL;
+	}
+
+	// Create dynamically memory for the maze with the dimension
+	element** markArray = (element**)calloc(dimension.Y, sizeof(element*));
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		markArray[index] = calloc(dimension.X, sizeof(element));
+	}
+
+	if (markArray == NULL)
+	{
+		printf("Error! - can not reserve memory for the %dx%d\n", dimension.X, dimension.Y);
+		exit(1);
+	}
+
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
 			// Create the wall type
 			if (field[indexY][indexX] == '1')
 			{
-				element content;
-				content.type = Wall;
-				markArray[indexY][indexX] = content;
-				continue;
+				element content = { 0 };
+				content.type = Wall;
+				content.cost = 0;
+				content.classified = TRUE;
+				markArray[indexY][indexX] = content;
+				continue;
+			}
+
+			// Create the destination type
+			if (field[indexY][indexX] == 'X')
+			{
+				element content = { 0 };
+				content.type = Destination;
+				content.cost = 1;
+				content.classified = TRUE;
+				markArray[indexY][indexX] = content;
+				continue;
+			}
+
+			// Corridors with a cost digit are corridors as well
+			markArray[indexY][indexX].cost = getTerrainCost(field[indexY][indexX]);
+			markArray[indexY][indexX].classified = TRUE;
+
+			/*
+			* Scan from top to bottom and left to right
+					   -->
+					  |	1 1 0 1 1
+					  v 1 1 M 1 1
+						0 M 0 M 0
+			Skip the M:	> > M >
+
+			*/
+
+			// When array is already marked skip this one
+			if (markArray[indexY][indexX].type == Marker)
+			{
+				continue;
+			}
+
+			// Check all directions if there is another corridor 
+			if (indexX > 0 && indexY > 0 && (isPassable(field[indexY][indexX]) || field[indexY][indexX] == 'X'))
+			{
+				// Count up all corridors possibilitys
+				int countCorners = 0;
+
+				// Check above for a corridor
+				if (isPassable(field[indexY - 1][indexX]))
+					countCorners++;
+
+				// Check right for a corridor
+				if (isPassable(field[indexY][indexX + 1]))
+					countCorners++;
+
+				// Check below for a corridor
+				if (isPassable(field[indexY + 1][indexX]))
+					countCorners++;
+
+				// Check left for a corridor
+				if (isPassable(field[indexY][indexX - 1]))
+					countCorners++;
+
+				// If there are more than two corridors mark everyone
+				/*
+				* Example 1   Example 2
+				   | |			   | |
+				___|M|___	       |M|___
+				__M   M__		   |  M__
+				   |M|			   |M|
+				   | |			   | |
+				*/
+
+				if (countCorners > 2)
+				{
+					if (countCorners > 3)
+					{
+						// More than 3 corridors -> everything have to be marked
+						if (field[indexY - 1][indexX] != 'X')
+							markArray[indexY - 1][indexX].type = Marker;
+
+						if (field[indexY][indexX + 1] != 'X')
+							markArray[indexY][indexX + 1].type = Marker;
+
+						if (field[indexY + 1][indexX] != 'X')
+							markArray[indexY + 1][indexX].type = Marker;
+
+						if (field[indexY][indexX - 1] != 'X')
+							markArray[indexY][indexX - 1].type = Marker;
+
+						// Check center is not marked
+						if (markArray[indexY][indexX].type != Marker)
+							markArray[indexY][indexX].type = Corridor;
+
+						continue;
+					}
+					else
+					{
+						// Check which direction is a corridor and mark this one
+						if (isPassable(field[indexY - 1][indexX]))
+							markArray[indexY - 1][indexX].type = Marker;
+
+						if (isPassable(field[indexY][indexX + 1]) && field[indexY][indexX + 1] != 'X')
+							markArray[indexY][indexX + 1].type = Marker;
+
+						if (isPassable(field[indexY + 1][indexX]) && field[indexY + 1][indexX] != 'X')
+							markArray[indexY + 1][indexX].type = Marker;
+
+						if (isPassable(field[indexY][indexX - 1]) && field[indexY][indexX - 1] != 'X')
+							markArray[indexY][indexX - 1].type = Marker;
+
+						// Check center is not marked
+						if (markArray[indexY][indexX].type != Marker)
+							markArray[indexY][indexX].type = Corridor;
+
+						continue;
+					}
+				}
+				else
+				{
+					// When there are less then three corridors it is a normal corridor
+					if (markArray[indexY][indexX].type != Marker)
+					{
+						markArray[indexY][indexX].type = Corridor;
+					}
+				}
+			}
+		}
+	}
+
+	return markArray;
+}
+
+/// <summary>
+/// Algorithm to solve complexe maze with calculation to get the way back to source
+/// </summary>
+/// <param name="view">window of the maze where to display the maze solving</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="speed">Delay time in milliseconds, 0 draws a frame every VIEWPORT_FRAME_TIME</param>
+void tremaux(viewport* view, COORD startPosition, int speed)
+{
+	if (view == NULL || view->elementField == NULL)
+	{
+		printf("Error - Something went wrong when start the algorithm!\n");
+		exit(1);
+	}
+
+	element** elementField = view->elementField;
+	COORD latestCoord = { 0 };
+	COORD currentCoord = startPosition;
+	COORD nextCoord = startPosition;
+
+	INSTR_PHASE_BEGIN(PhaseSolve);
+
+	// The rules only look at the neighbours, so the on-demand content is classified before every step
+	if (view->isOnDemand)
+		classifyNeighbours(elementField, view->field, view->dimension, startPosition);
+
+	// Iterate the algorithm until the current coordination is the destination
+	while (elementField[nextCoord.Y][nextCoord.X].type != Destination)
+	{
+		// Set current Coordination
+		currentCoord = nextCoord;
+
+		if (view->isOnDemand)
+			classifyNeighbours(elementField, view->field, view->dimension, currentCoord);
+
+		// get next Coordination by passing by the rules
+		nextCoord = firstRule(elementField, currentCoord, latestCoord);
+		INSTR_COUNT(steps);
+		INSTR_DIRECTION(currentCoord, nextCoord);
+
+		if (nextCoord.X == 0 && nextCoord.Y == 0)
+		{
+			drawViewport(view, TRUE);
+			printViewportStatus(view, "Error - Maze has no solution!\n");
+			exit(1);
+		}
+
+		// set latest Coordination
+		latestCoord = currentCoord;
+
+		// When step on a marker tag this one
+		if (elementField[currentCoord.Y][currentCoord.X].type == Marker)
+		{
+			// If this marker has not been used yet, tag this for the first time
+			if (elementField[currentCoord.Y][currentCoord.X].markOne == FALSE)
+			{
+				elementField[currentCoord.Y][currentCoord.X].markOne = TRUE;
+				INSTR_COUNT(markOneTags);
+			}
+			// If this marker is already taged once, mark this a second time
+			else if (elementField[currentCoord.Y][currentCoord.X].markTwo == FALSE)
+			{
+				elementField[currentCoord.Y][currentCoord.X].markTwo = TRUE;
+				INSTR_COUNT(markTwoTags);
+			}
+		}
+
+		// Drawing and delay are no part of the measured solve
+		INSTR_PHASE_END(PhaseSolve);
+
+		// The latest position of the Roboter is drawn again with its tag
+		moveViewportRobot(view, nextCoord);
+
+		// Without delay only some steps get a frame of their own
+		if (speed > 0)
+		{
+			drawViewport(view, TRUE);
+			Sleep(speed);
+		}
+		else
+		{
+			drawViewport(view, FALSE);
+		}
+
+		INSTR_PHASE_BEGIN(PhaseSolve);
+	}
+
+	INSTR_PHASE_END(PhaseSolve);
+
+	// Display the solution
+	drawViewport(view, TRUE);
+	printViewportStatus(view, "Found one way to the destination");
+
+	Sleep(SHOW_SETTINGS_TIME);
+
+	// Start the algorithm to find the way back to the source
+	INSTR_PHASE_BEGIN(PhasePath);
+	int stepsBack = getWayBack(view, startPosition, nextCoord, speed);
+	INSTR_PHASE_END(PhasePath);
+
+	char message[VIEWPORT_LINE_BYTES];
+	snprintf(message, VIEWPORT_LINE_BYTES, "Shortes way to destination in %d steps\n", stepsBack);
+	printViewportStatus(view, message);
+	Sleep(SHOW_SETTINGS_TIME);
+}
+
+/// <summary>
+/// You do not talk about Fight Club!
+/// Calculate the next coordination for the maze and compare all types from the field
+/// </summary>
+/// <param name="markField">Maze field with all types and tag values</param>
+/// <param name="currentCoord">Coordination to calculate all directions</param>
+/// <param name="latestCoord">Coordination to compare with possible next step</param>
+/// <returns>Coordination when all conditions for the first Trmaux' rule are passed</returns>
+COORD firstRule(element** markField, COORD currentCoord, COORD latestCoord)
+{
+	INSTR_COUNT(firstRuleCalls);
+
+	// Check all direction in the following sequence 
+	/*
+			Third
+			  ^
+			  |
+	Fourth < - - > Second
+			  |
+			  v
+			First
+	*/
+
+	// Check bottom direction is not the latest position and not a wall
+	if ((markField[currentCoord.Y + 1][currentCoord.X].type != Wall)
+		&& (currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X))
+	{
+		// Check bottem direction is not a tag otherwise call second rule
+		if (markField[currentCoord.Y + 1][currentCoord.X].type != Marker)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+		else
+		{
+			// The next position is a tag so check all other tags value
+			return secondRule(markField, currentCoord);
+		}
+	}
+
+	// Check right direction is not the latest position and not a wall
+	else if ((markField[currentCoord.Y][currentCoord.X + 1].type != Wall)
+		&& (currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X))
+	{
+		// Check right direction is not a tag otherwise call second rule
+		if (markField[currentCoord.Y][currentCoord.X + 1].type != Marker)
+		{
+			currentCoord.X++;
+			return currentCoord;
+		}
+		else
+		{
+			// The next position is a tag so check all other tags value
+			return secondRule(markField, currentCoord);
+		}
+	}
+
+	// Check top direction is not the latest position and not a wall
+	else if ((markField[currentCoord.Y - 1][currentCoord.X].type != Wall)
+		&& (currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X))
+	{
+		// Check top direction is not a tag otherwise call second rule
+		if (markField[currentCoord.Y - 1][currentCoord.X].type != Marker)
+		{
+			currentCoord.Y--;
+			return currentCoord;
+		}
+		else
+		{
+			// The next position is a tag so check all other tags value
+			return secondRule(markField, currentCoord);
+		}
+	}
+
+	// Check left direction is not the latest position and not a wall
+	else if ((markField[currentCoord.Y][currentCoord.X - 1].type != Wall)
+		&& (currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X))
+	{
+		// Check left direction is not a tag otherwise call second rule
+		if (markField[currentCoord.Y][currentCoord.X - 1].type != Marker)
+		{
+			currentCoord.X--;
+			return currentCoord;
+		}
+		else
+		{
+			// The next position is a tag so check all other tags value
+			return secondRule(markField, currentCoord);
+		}
+	}
+
+	return currentCoord;
+}
+
+/// <summary>
+/// You do !NOT! talk about Fight Club!
+/// When step on a tag element check all others and go to this direction with the lowest tag value
+/// </summary>
+/// <param name="markField">Maze field with all types and tag values</param>
+/// <param name="currentCoord">Coordination to get present position</param>
+/// <returns>Coordination when all conditions for the second Trmaux' rule are passed - returns 0:0 if maze is not solvable</returns>
+COORD secondRule(element** markField, COORD currentCoord)
+{
+	INSTR_COUNT(secondRuleCalls);
+
+	int botDirection = 0;
+	int rightDirection = 0;
+	int topDirection = 0;
+	int leftDirection = 0;
+
+	// Check if bottom is a marker and count the value
+	if (markField[currentCoord.Y + 1][currentCoord.X].type == Marker)
+	{
+		botDirection++;
+
+		if (markField[currentCoord.Y + 1][currentCoord.X].markOne == TRUE)
+			botDirection++;
+
+		if (markField[currentCoord.Y + 1][currentCoord.X].markTwo == TRUE)
+			botDirection++;
+
+		// When bottom is a marker with value 0 return bottom 
+		if (botDirection == 1)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+	}
+	// Check if right is a marker and count the value
+	if (markField[currentCoord.Y][currentCoord.X + 1].type == Marker)
+	{
+		rightDirection++;
+
+		if (markField[currentCoord.Y][currentCoord.X + 1].markOne == TRUE)
+			rightDirection++;
+
+		if (markField[currentCoord.Y][currentCoord.X + 1].markTwo == TRUE)
+			rightDirection++;
+
+		// When right is a marker with value 0 return right 
+		if (rightDirection == 1)
+		{
+			currentCoord.X++;
+			return currentCoord;
+		}
+	}
+	// Check if top is a markerand count the value
+	if (markField[currentCoord.Y - 1][currentCoord.X].type == Marker)
+	{
+		topDirection++;
+
+		if (markField[currentCoord.Y - 1][currentCoord.X].markOne == TRUE)
+			topDirection++;
+
+		if (markField[currentCoord.Y - 1][currentCoord.X].markTwo == TRUE)
+			topDirection++;
+
+		// When top is a marker with value 0 return top 
+		if (topDirection == 1)
+		{
+			currentCoord.Y--;
+			return currentCoord;
+		}
+	}
+	// Check if left is a marker and count the value
+	if (markField[currentCoord.Y][currentCoord.X - 1].type == Marker)
+	{
+		leftDirection++;
+
+		if (markField[currentCoord.Y][currentCoord.X - 1].markOne == TRUE)
+			leftDirection++;
+
+		if (markField[currentCoord.Y][currentCoord.X - 1].markTwo == TRUE)
+			leftDirection++;
+
+		// When left is a marker with value 0 return left 
+		if (leftDirection == 1)
+		{
+			currentCoord.X--;
+			return currentCoord;
+		}
+	}
+
+	// Compare all values with bottom tag value
+	if (botDirection > 0 && botDirection < LIMIT_STEPS_ON_MARKER)
+	{
+		if (rightDirection <= 0 && topDirection <= 0 && leftDirection <= 0)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+		else if (botDirection <= rightDirection)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+		else if (botDirection <= topDirection)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+		else if (botDirection <= leftDirection)
+		{
+			currentCoord.Y++;
+			return currentCoord;
+		}
+	}
+	// Compare all values with right tag value
+	if (rightDirection > 0 && rightDirection < LIMIT_STEPS_ON_MARKER)
+	{
+		if (topDirection <= 0 && leftDirection <= 0)
+		{
+			currentCoord.X++;
+			return currentCoord;
+		}
+		else if (rightDirection <= topDirection)
+		{
+			currentCoord.X++;
+			return currentCoord;
+		}
+		else if (rightDirection <= leftDirection)
+		{
+			currentCoord.X++;
+			return currentCoord;
+		}
+	}
+	// Compare all values with top tag value
+	if (topDirection > 0 && topDirection < LIMIT_STEPS_ON_MARKER)
+	{
+		if (leftDirection <= 0)
+		{
+			currentCoord.Y--;
+			return currentCoord;
+		}
+		else if (topDirection <= leftDirection)
+		{
+			currentCoord.Y--;
+			return currentCoord;
+		}
+	}
+	// Compare all values with left tag value
+	if (leftDirection > 0 && leftDirection < LIMIT_STEPS_ON_MARKER)
+	{
+		currentCoord.X--;
+		return currentCoord;
+	}
+
+	// When stepping into this the maze is not solvable
+	currentCoord.X = 0;
+	currentCoord.Y = 0;
+
+	return currentCoord;
+}
+
+/// <summary>
+/// Helper to get the shortes way back to source from destination with the tagged maze content
+/// </summary>
+/// <param name="markField">maze with the markings and their values</param>
+/// <param name="currentCoord">Coordination to get present position</param>
+/// <param name="latestCoord">Coordination to compare with possible next step</param>
+/// <returns>Coordination with the next step to get back to source - returns latest coordination if something went wrong</returns>
+COORD getNextStepBack(element** markField, COORD currentCoord, COORD latestCoord)
+{
+	// Check bottom is a marker with only one tag and not latest step
+	if ((currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
+		&& (markField[currentCoord.Y + 1][currentCoord.X].type == Marker)
+		&& (markField[currentCoord.Y + 1][currentCoord.X].markOne == TRUE)
+		&& (markField[currentCoord.Y + 1][currentCoord.X].markTwo == FALSE))
+	{
+		currentCoord.Y++;
+		return currentCoord;
+	}
+
+	// Check right is a marker with only one tag and not latest step
+	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X)
+		&& (markField[currentCoord.Y][currentCoord.X + 1].type == Marker)
+		&& (markField[currentCoord.Y][currentCoord.X + 1].markOne == TRUE)
+		&& (markField[currentCoord.Y][currentCoord.X + 1].markTwo == FALSE))
+	{
+		currentCoord.X++;
+		return currentCoord;
+	}
+
+	// Check top is a marker with only one tag and not latest step
+	else if ((currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
+		&& (markField[currentCoord.Y - 1][currentCoord.X].type == Marker)
+		&& (markField[currentCoord.Y - 1][currentCoord.X].markOne == TRUE)
+		&& (markField[currentCoord.Y - 1][currentCoord.X].markTwo == FALSE))
+	{
+		currentCoord.Y--;
+		return currentCoord;
+	}
+
+	// Check left is a marker with only one tag and not latest step
+	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X)
+		&& (markField[currentCoord.Y][currentCoord.X - 1].type == Marker)
+		&& (markField[currentCoord.Y][currentCoord.X - 1].markOne == TRUE)
+		&& (markField[currentCoord.Y][currentCoord.X - 1].markTwo == FALSE))
+	{
+		currentCoord.X--;
+		return currentCoord;
+	}
+
+	// If there is no marker with one tag, check for the next corridor which is not the latest step
+	if ((currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
+		&& (markField[currentCoord.Y + 1][currentCoord.X].type == Corridor))
+	{
+		currentCoord.Y++;
+		return currentCoord;
+	}
+	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X)
+		&& (markField[currentCoord.Y][currentCoord.X + 1].type == Corridor))
+	{
+		currentCoord.X++;
+		return currentCoord;
+	}
+	else if ((currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
+		&& (markField[currentCoord.Y - 1][currentCoord.X].type == Corridor))
+	{
+		currentCoord.Y--;
+		return currentCoord;
+	}
+	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X)
+		&& (markField[currentCoord.Y][currentCoord.X - 1].type == Corridor))
+	{
+		currentCoord.X--;
+		return currentCoord;
+	}
+	// Return latest coordination if there is no possible direction 
+	else
+	{
+		// Something went wrong
+		return latestCoord;
+	}
+}
+
+/// <summary>
+/// Calculate the shortest way from destination to source in the maze. Thourgh the simply highlighted tags.
+/// </summary>
+/// <param name="view">window of the maze with the markings and their values</param>
+/// <param name="startPosition">Source must be adjusted back to</param>
+/// <param name="mazeDesination">Destination of the maze, where to start from</param>
+/// <param name="speed">Delay time in milliseconds</param>
+/// <returns>Steps number from destination to source coordination</returns>
+int getWayBack(viewport* view, COORD startPosition, COORD mazeDesination, int speed)
+{
+	element** markField = view->elementField;
+	COORD nextCoord = mazeDesination;
+	COORD latestCoord = { 0 };
+	COORD currentCoord = { 0 };
+	int countBack = 0;
+
+	// Analyze the coordination until the current coordination is the source
+	while ((nextCoord.X != startPosition.X) || (nextCoord.Y != startPosition.Y))
+	{
+		currentCoord = nextCoord;
+
+		if (view->isOnDemand)
+			classifyNeighbours(markField, view->field, view->dimension, currentCoord);
+
+		nextCoord = getNextStepBack(markField, currentCoord, latestCoord);
+
+		// When get back the latest coordination something went wrong
+		if (nextCoord.X == latestCoord.X && nextCoord.Y == latestCoord.Y)
+		{
+			printViewportStatus(view, "Error! - something went wrong when calculating the way back to source!\n");
+			exit(1);
+		}
+
+		markField[nextCoord.Y][nextCoord.X].onWay = TRUE;
+		latestCoord = currentCoord;
+		countBack++;
+		view->stepsBack = countBack;
+		INSTR_COUNT(wayBackSteps);
+
+		// Drawing and delay are no part of the measured way back
+		INSTR_PHASE_END(PhasePath);
+
+		// The window follows the way back instead of the robot
+		markViewportCell(view, nextCoord);
+
+		if (view->follow)
+			followViewport(view, nextCoord);
+
+		if (speed > 0)
+		{
+			drawViewport(view, TRUE);
+			Sleep(speed);
+		}
+		else
+		{
+			drawViewport(view, FALSE);
+		}
+
+		INSTR_PHASE_BEGIN(PhasePath);
+	}
+
+	drawViewport(view, TRUE);
+
+	return countBack;
+}
+
+/// <summary>
+/// Command line of the maze generator:
+/// generate <file> <width> <height> [-seed N] [-loops percent] [-rooms percent] [-dest corner|center|random] [-binary] [-levels N] [-stairs N]
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when the maze was written</returns>
+int runGenerator(int argc, char* argv[])
+{
+	if (argc < 5)
+	{
+		printf("Usage: %s generate <file> <width> <height> [-seed N] [-loops percent] [-rooms percent] [-dest corner|center|random] [-binary] [-levels N] [-stairs N]\n", argv[0]);
+		return 1;
+	}
+
+	generatorSettings settings = { 0 };
+	settings.width = atoll(argv[3]);
+	settings.height = atoll(argv[4]);
+	settings.seed = GENERATOR_SEED;
+	settings.destination = DestinationCorner;
+	settings.levels = 1;
+	settings.stairs = GENERATOR_STAIRS;
+
+	for (int index = 5; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-binary") == 0)
+			settings.binary = TRUE;
+		else if (strcmp(argv[index], "-seed") == 0 && index + 1 < argc)
+			settings.seed = strtoull(argv[++index], NULL, 10);
+		else if (strcmp(argv[index], "-loops") == 0 && index + 1 < argc)
+			settings.loopPercent = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-rooms") == 0 && index + 1 < argc)
+			settings.roomPercent = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-levels") == 0 && index + 1 < argc)
+			settings.levels = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-stairs") == 0 && index + 1 < argc)
+			settings.stairs = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-dest") == 0 && index + 1 < argc)
+		{
+			index++;
+
+			if (strcmp(argv[index], "center") == 0)
+				settings.destination = DestinationCenter;
+			else if (strcmp(argv[index], "random") == 0)
+				settings.destination = DestinationRandom;
+			else
+				settings.destination = DestinationCorner;
+		}
+		else
+		{
+			printf("Error - unknown generator option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	unsigned long long startTime = GetTickCount64();
+
+	if (generateMaze(argv[2], settings) != TRUE)
+		return 1;
+
+	printf("Generated %lldx%lldx%d maze in %llums\n", settings.width, settings.height, settings.levels, GetTickCount64() - startTime);
+
+	return 0;
+}
+
+/// <summary>
+/// Fast pseudo random numbers (xorshift64*) so the same seed always creates the same maze
+/// </summary>
+/// <param name="state">of the generator, must not be zero</param>
+/// <returns>Next random number</returns>
+unsigned long long nextRandom(unsigned long long* state)
+{
+	unsigned long long value = *state;
+
+	value ^= value >> 12;
+	value ^= value << 25;
+	value ^= value >> 27;
+	*state = value;
+
+	return value * 0x2545F4914F6CDD1DULL;
+}
+
+/// <summary>
+/// Generate a maze row by row with Eller's algorithm and stream it into a file.
+/// Only the current row is kept in memory, every set is a circular list of cells sorted by column.
+/// A building gets one maze per level, connected by stairs at random cells, the destination is on the top level.
+/// </summary>
+/// <param name="pathToField">target file for the maze</param>
+/// <param name="settings">size, seed and options of the maze</param>
+/// <returns>True when the complete maze was written</returns>
+bool generateMaze(char* pathToField, generatorSettings settings)
+{
+	long long cellsX = (settings.width - 1) / 2;
+	long long cellsY = (settings.height - 1) / 2;
+
+	if (cellsX < 1 || cellsY < 1 || cellsX * cellsY < 2)
+	{
+		printf("Error - the dimension [ %lld | %lld ] is to short to generate a maze!\n", settings.width, settings.height);
+		return FALSE;
+	}
+
+	int levels = settings.levels > 1 ? settings.levels : 1;
+
+	// Every reader of a maze with one level keeps the dimension in a COORD
+	if (levels == 1 && (settings.width > SHRT_MAX || settings.height > SHRT_MAX))
+	{
+		printf("Error - the dimension [ %lld | %lld ] is larger than %d, which no maze reader can load\n", settings.width, settings.height, SHRT_MAX);
+		return FALSE;
+	}
+
+	if (levels > 1 && (settings.stairs < 1 || settings.width > INT_MAX || settings.height > INT_MAX))
+	{
+		printf("Error - a building needs at least one stair between two levels\n");
+		return FALSE;
+	}
+
+	generatorOutput output = { 0 };
+	errno_t errNo = fopen_s(&output.file, pathToField, "wb");
+
+	if (errNo != 0)
+	{
+		printf("Error! - this file can not be open\n");
+		return FALSE;
+	}
+
+	// Rows are collected in a large block, so the stream does not need its own buffer
+	setvbuf(output.file, NULL, _IONBF, 0);
+
+	output.width = settings.width;
+	output.binary = settings.binary;
+	output.levels = levels;
+	output.rowSize = settings.binary ? (levels > 1 ? (settings.width + 1) / 2 : (settings.width + 3) / 4) : 2 * settings.width;
+	output.blockSize = output.rowSize > GENERATOR_IO_BUFFER ? output.rowSize : GENERATOR_IO_BUFFER;
+	output.block = (unsigned char*)malloc(output.blockSize);
+
+	// Set lists of the current row, the open walls and the running rooms per column
+	long long* leftCell = (long long*)malloc(cellsX * sizeof(long long));
+	long long* rightCell = (long long*)malloc(cellsX * sizeof(long long));
+	bool* openRight = (bool*)calloc(cellsX, sizeof(bool));
+	bool* openDown = (bool*)calloc(cellsX, sizeof(bool));
+	long long* roomRowsLeft = (long long*)calloc(cellsX, sizeof(long long));
+	long long* roomId = (long long*)calloc(cellsX, sizeof(long long));
+
+	// One row of the matrix: 0 = corridor, 1 = wall, 2 = destination, 3 = stairs up, 4 = stairs down, 5 = elevator
+	char* elements = (char*)malloc(settings.width);
+
+	// Cells of the stairs between every level and the one above
+	long long* stairCells = (long long*)malloc(((size_t)levels - 1) * settings.stairs * sizeof(long long) + sizeof(long long));
+
+	if (output.block == NULL || leftCell == NULL || rightCell == NULL || openRight == NULL || openDown == NULL
+		|| roomRowsLeft == NULL || roomId == NULL || elements == NULL || stairCells == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	unsigned long long random = settings.seed * 0x9E3779B97F4A7C15ULL + 1;
+
+	if (random == 0)
+		random = 1;
+
+	// Place the destination in cell coordinations
+	long long destinationX = cellsX - 1;
+	long long destinationY = cellsY - 1;
+
+	if (settings.destination == DestinationCenter)
+	{
+		destinationX = cellsX / 2;
+		destinationY = cellsY / 2;
+	}
+	else if (settings.destination == DestinationRandom)
+	{
+		destinationX = (long long)(nextRandom(&random) % (unsigned long long)cellsX);
+		destinationY = (long long)(nextRandom(&random) % (unsigned long long)cellsY);
+	}
+
+	// The start position 1:1 can not be the destination
+	if (destinationX == 0 && destinationY == 0)
+	{
+		destinationX = cellsX - 1;
+		destinationY = cellsY - 1;
+	}
+
+	// Neither the start nor the destination become stairs
+	for (long long stair = 0; stair < (long long)(levels - 1) * settings.stairs; stair++)
+	{
+		do
+		{
+			stairCells[stair] = (long long)(nextRandom(&random) % (unsigned long long)(cellsX * cellsY));
+		} while (stairCells[stair] == 0 || stairCells[stair] == destinationY * cellsX + destinationX);
+	}
+
+	// Write the header
+	if (settings.binary)
+	{
+		unsigned int header[3] = { (unsigned int)settings.width, (unsigned int)settings.height, (unsigned int)levels };
+
+		fwrite(levels > 1 ? BUILDING_MAGIC : PACKED_MAGIC, 1, PACKED_MAGIC_SIZE, output.file);
+		fwrite(header, sizeof(unsigned int), levels > 1 ? 3 : 2, output.file);
+	}
+	else if (levels > 1)
+	{
+		fprintf(output.file, "%lld %lld %d\n", settings.width, settings.height, levels);
+	}
+	else
+	{
+		fprintf(output.file, "%lld %lld\n", settings.width, settings.height);
+	}
+
+	long long roomCounter = 0;
+
+	for (int level = 0; level < levels; level++)
+	{
+		// Upper wall, every cell starts in its own set
+		memset(elements, 1, settings.width);
+		writeGeneratedRow(&output, elements);
+
+		for (long long cellX = 0; cellX < cellsX; cellX++)
+		{
+			leftCell[cellX] = cellX;
+			rightCell[cellX] = cellX;
+		}
+
+		for (long long cellY = 0; cellY < cellsY; cellY++)
+		{
+			bool lastRow = cellY == cellsY - 1;
+
+			// Insert new rooms which start in this row
+			for (long long cellX = 0; settings.roomPercent > 0 && cellX < cellsX; cellX++)
+			{
+				if (roomRowsLeft[cellX] > 0 || (int)(nextRandom(&random) % 100) >= settings.roomPercent)
+					continue;
+
+				long long roomWidth = GENERATOR_ROOM_MIN + (long long)(nextRandom(&random) % (GENERATOR_ROOM_MAX - GENERATOR_ROOM_MIN + 1));
+				long long roomHeight = GENERATOR_ROOM_MIN + (long long)(nextRandom(&random) % (GENERATOR_ROOM_MAX - GENERATOR_ROOM_MIN + 1));
+
+				if (cellX + roomWidth > cellsX || cellY + roomHeight > cellsY)
+					continue;
+
+				bool isFree = TRUE;
+
+				for (long long index = cellX; index < cellX + roomWidth; index++)
+				{
+					if (roomRowsLeft[index] > 0)
+						isFree = FALSE;
+				}
+
+				if (isFree != TRUE)
+					continue;
+
+				roomCounter++;
+
+				for (long long index = cellX; index < cellX + roomWidth; index++)
+				{
+					roomRowsLeft[index] = roomHeight;
+					roomId[index] = roomCounter;
+				}
+
+				// Leave at least one column between two rooms
+				cellX += roomWidth;
+			}
+
+			// Join neighbours of diffrent sets randomly, in the last row all of them.
+			// The random decisions are not predictable, so the lists are updated without branches.
+			unsigned long long randomBits = 0;
+
+			for (long long cellX = 0; cellX < cellsX - 1; cellX++)
+			{
+				// One random number serves the next 64 decisions
+				if ((cellX & 63) == 0)
+					randomBits = nextRandom(&random);
+
+				bool coin = (randomBits >> (cellX & 63)) & 1;
+				bool sameRoom = roomRowsLeft[cellX] > 0 && roomRowsLeft[cellX + 1] > 0 && roomId[cellX] == roomId[cellX + 1];
+				bool sameSet = rightCell[cellX] == cellX + 1;
+				bool join = (sameSet == FALSE) & (lastRow | sameRoom | coin);
+
+				// Removing a wall inside one set creates a loop and braids the maze
+				bool loop = sameSet & sameRoom;
+
+				if (settings.loopPercent > 0 && sameSet)
+					loop |= (int)(nextRandom(&random) % 100) < settings.loopPercent;
+
+				// Splice the list of the right neighbour behind this cell
+				long long leftOfNext = leftCell[cellX + 1];
+				long long rightOfCell = rightCell[cellX];
+
+				rightCell[leftOfNext] = join ? rightOfCell : rightCell[leftOfNext];
+				leftCell[rightOfCell] = join ? leftOfNext : leftCell[rightOfCell];
+				rightCell[cellX] = join ? cellX + 1 : rightCell[cellX];
+				leftCell[cellX + 1] = join ? cellX : leftCell[cellX + 1];
+
+				openRight[cellX] = join | loop;
+			}
+
+			openRight[cellsX - 1] = FALSE;
+
+			// Every set needs at least one way down, the other cells may leave their set
+			for (long long cellX = 0; cellX < cellsX; cellX++)
+			{
+				if ((cellX & 63) == 0)
+					randomBits = nextRandom(&random);
+
+				bool coin = (randomBits >> (cellX & 63)) & 1;
+				bool leave = (lastRow == FALSE) & (roomRowsLeft[cellX] <= 1) & (leftCell[cellX] != cellX) & coin;
+
+				long long leftOfCell = leftCell[cellX];
+				long long rightOfCell = rightCell[cellX];
+
+				rightCell[leftOfCell] = leave ? rightOfCell : rightCell[leftOfCell];
+				leftCell[rightOfCell] = leave ? leftOfCell : leftCell[rightOfCell];
+				leftCell[cellX] = leave ? cellX : leftOfCell;
+				rightCell[cellX] = leave ? cellX : rightOfCell;
+
+				openDown[cellX] = (lastRow == FALSE) & (leave == FALSE);
+			}
+
+			// Write the row with the cells and the walls between them
+			memset(elements, 1, settings.width);
+
+			for (long long cellX = 0; cellX < cellsX; cellX++)
+			{
+				elements[2 * cellX + 1] = 0;
+				elements[2 * cellX + 2] = !openRight[cellX];
+			}
+
+			if (cellY == destinationY && level == levels - 1)
+				elements[2 * destinationX + 1] = 2;
+
+			// Stairs up to the next level and down to the one before, both together are an elevator.
+			// A cell can be drawn twice for a level, so the directions are merged and never taken back.
+			for (long long stair = 0; stair < (long long)(levels - 1) * settings.stairs; stair++)
+			{
+				long long stairLevel = stair / settings.stairs;
+				long long stairX = stairCells[stair] % cellsX;
+				char code = elements[2 * stairX + 1];
+
+				if (stairCells[stair] / cellsX != cellY)
+					continue;
+
+				if (stairLevel == level)
+					elements[2 * stairX + 1] = (code == 4 || code == 5) ? 5 : 3;
+				else if (stairLevel == level - 1)
+					elements[2 * stairX + 1] = (code == 3 || code == 5) ? 5 : 4;
+			}
+
+			writeGeneratedRow(&output, elements);
+
+			// Write the row with the walls below the cells, rooms have no pillars inside
+			for (long long cellX = 0; cellX < cellsX; cellX++)
+			{
+				elements[2 * cellX + 1] = !openDown[cellX];
+				elements[2 * cellX + 2] = 1;
+			}
+
+			for (long long cellX = 0; cellX < cellsX; cellX++)
+			{
+				if (roomRowsLeft[cellX] == 0)
+					continue;
+
+				if (cellX < cellsX - 1 && roomRowsLeft[cellX] > 1 && roomRowsLeft[cellX + 1] > 1 && roomId[cellX] == roomId[cellX + 1])
+					elements[2 * cellX + 2] = 0;
+
+				roomRowsLeft[cellX]--;
+			}
+
+			writeGeneratedRow(&output, elements);
+		}
+
+		// An even height gets one more wall at the bottom
+		memset(elements, 1, settings.width);
+
+		for (long long rowY = 2 * cellsY + 1; rowY < settings.height; rowY++)
+		{
+			writeGeneratedRow(&output, elements);
+		}
+	}
+
+	// Write what is left in the block
+	if (output.blockUsed > 0)
+		fwrite(output.block, 1, output.blockUsed, output.file);
+
+	bool isWritten = ferror(output.file) == 0;
+
+	if (fclose(output.file) != 0)
+		isWritten = FALSE;
+
+	if (isWritten != TRUE)
+		printf("Error - Failed to write the maze to %s\n", pathToField);
+
+	free(output.block);
+	free(leftCell);
+	free(rightCell);
+	free(openRight);
+	free(openDown);
+	free(roomRowsLeft);
+	free(roomId);
+	free(elements);
+	free(stairCells);
+
+	return isWritten;
+}
+
+/// <summary>
+/// Encode one row of the matrix into the output block, either as text with 0, 1 and X or packed with two bits per element.
+/// Buildings with several levels are packed with four bits per element. A full block is written to the file in one go.
+/// </summary>
+/// <param name="output">file and block of the generator</param>
+/// <param name="elements">of the row: 0 = corridor, 1 = wall, 2 = destination, 3 = stairs up, 4 = stairs down, 5 = elevator</param>
+void writeGeneratedRow(generatorOutput* output, char* elements)
+{
+	if (output->blockUsed + output->rowSize > output->blockSize)
+	{
+		fwrite(output->block, 1, output->blockUsed, output->file);
+		output->blockUsed = 0;
+	}
+
+	unsigned char* row = output->block + output->blockUsed;
+	long long width = output->width;
+
+	if (output->binary && output->levels > 1)
+	{
+		// Two elements per byte like the building in memory, an odd row ends with a wall
+		for (long long indexX = 0; indexX < width; indexX += 2)
+		{
+			row[indexX >> 1] = (unsigned char)(elements[indexX] | ((indexX + 1 < width ? elements[indexX + 1] : BuildingWall) << 4));
+		}
+	}
+	else if (output->binary)
+	{
+		// Four elements per byte, the first element in the lowest bits
+		long long indexX = 0;
+
+		for (; indexX + 4 <= width; indexX += 4)
+		{
+			row[indexX >> 2] = (unsigned char)(elements[indexX] | (elements[indexX + 1] << 2)
+				| (elements[indexX + 2] << 4) | (elements[indexX + 3] << 6));
+		}
+
+		if (indexX < width)
+		{
+			unsigned char packed = 0;
+
+			for (int shift = 0; indexX < width; indexX++, shift += 2)
+			{
+				packed |= (unsigned char)(elements[indexX] << shift);
+			}
+
+			row[output->rowSize - 1] = packed;
+		}
+	}
+	else
+	{
+		static const unsigned char elementCharacters[6] = { '0', '1', 'X', '^', 'v', 'E' };
+
+		for (long long indexX = 0; indexX < width; indexX++)
+		{
+			row[2 * indexX] = elementCharacters[(int)elements[indexX]];
+			row[2 * indexX + 1] = EMPTY_SPACE;
+		}
+
+		row[2 * width - 1] = '\n';
+	}
+
+	output->blockUsed += output->rowSize;
+}
+
+/// <summary>
+/// Check if the file starts with the magic of the packed form
+/// </summary>
+/// <param name="pathToField">for the target maze</param>
+/// <returns>True when the maze is packed with two bits per element</returns>
+bool isPackedMaze(char* pathToField)
+{
+	FILE* file;
+	errno_t errNo = fopen_s(&file, pathToField, "rb");
+
+	if (errNo != 0)
+		return FALSE;
+
+	char magic[PACKED_MAGIC_SIZE] = { 0 };
+	size_t count = fread(magic, 1, PACKED_MAGIC_SIZE, file);
+
+	fclose(file);
+
+	return count == PACKED_MAGIC_SIZE && memcmp(magic, PACKED_MAGIC, PACKED_MAGIC_SIZE) == 0;
+}
+
+/// <summary>
+/// Read a maze in the packed form and unpack it into the same array as scanFieldFromPath
+/// </summary>
+/// <param name="pathToField">for the target maze</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <returns>Dynamically array with the content of the maze - returns NULL when the file can not be read completely</returns>
+char** scanFieldFromPackedPath(char* pathToField, COORD* dimension)
+{
+	FILE* file;
+	errno_t errNo = fopen_s(&file, pathToField, "rb");
+
+	if (errNo != 0)
+	{
+		printf("Error! - %s can not be open\n", pathToField);
+		return NULL;
+	}
+
+	char magic[PACKED_MAGIC_SIZE];
+	unsigned int header[2] = { 0 };
+
+	if (fread(magic, 1, PACKED_MAGIC_SIZE, file) != PACKED_MAGIC_SIZE
+		|| fread(header, sizeof(unsigned int), 2, file) != 2
+		|| header[0] > SHRT_MAX || header[1] > SHRT_MAX)
+	{
+		printf("Error - the header of the packed maze is not valid\n");
+		fclose(file);
+		return NULL;
+	}
+
+	dimension->X = (SHORT)header[0];
+	dimension->Y = (SHORT)header[1];
+
+	size_t packedSize = (header[0] + 3) / 4;
+	unsigned char* buffer = (unsigned char*)malloc(packedSize + 1);
+	char** field = (char**)calloc(dimension->Y, sizeof(char*));
+
+	if (field == NULL || buffer == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	static const char elementCodes[4] = { '0', '1', 'X', '1' };
+
+	for (int indexY = 0; indexY < dimension->Y; indexY++)
+	{
+		field[indexY] = calloc(dimension->X, sizeof(char));
+
+		if (field[indexY] == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
+
+		// A truncated file is reported to the caller like a wrong header
+		if (fread(buffer, 1, packedSize, file) != packedSize)
+		{
+			printf("Error - the packed maze %s is to short\n", pathToField);
+
+			for (int index = 0; index <= indexY; index++)
+			{
+				free(field[index]);
+			}
+
+			free(field);
+			free(buffer);
+			fclose(file);
+			return NULL;
+		}
+
+		for (int indexX = 0; indexX < dimension->X; indexX++)
+		{
+			field[indexY][indexX] = elementCodes[(buffer[indexX >> 2] >> ((indexX & 3) * 2)) & 3];
+		}
+	}
+
+	free(buffer);
+	fclose(file);
+
+	return field;
+}
+
+/// <summary>
+/// Command line of the batch mode:
+/// batch <maze> <starts> [-routes] - the starts file has one start position "X Y" per line
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when all agents were processed</returns>
+int runBatch(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		printf("Usage: %s batch <maze> <starts> [-routes]\n", argv[0]);
+		return 1;
+	}
+
+	bool printRoutes = argc > 4 && strcmp(argv[4], "-routes") == 0;
+
+	FILE* file;
+	errno_t errNo = fopen_s(&file, argv[3], "r");
+
+	if (errNo != 0)
+	{
+		printf("Error! - the file with the start positions can not be open\n");
+		return 1;
+	}
+
+	// Read all start positions, one per line
+	int agentCount = 0;
+	int agentCapacity = BATCH_CAPACITY;
+	COORD* starts = (COORD*)malloc(agentCapacity * sizeof(COORD));
+	char buffer[BUFFER_SIZE];
+
+	while (starts != NULL && fgets(buffer, BUFFER_SIZE, file) != NULL)
+	{
+		if (buffer[0] == '\n' || buffer[0] == '\r')
+			continue;
+
+		if (agentCount == agentCapacity)
+		{
+			agentCapacity *= 2;
+			starts = (COORD*)realloc(starts, agentCapacity * sizeof(COORD));
+
+			if (starts == NULL)
+				break;
+		}
+
+		starts[agentCount] = getDimension(buffer);
+		agentCount++;
+	}
+
+	fclose(file);
+
+	COORD dimension = { 0 };
+	char** field = scanFieldFromPath(argv[2], &dimension);
+	int* steps = (int*)malloc((agentCount + 1) * sizeof(int));
+
+	if (starts == NULL || field == NULL || steps == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	unsigned long long startTime = GetTickCount64();
+	int* distances = solveBatch(field, dimension, starts, agentCount, steps);
+	unsigned long long elapsed = GetTickCount64() - startTime;
+
+	for (int agent = 0; agent < agentCount; agent++)
+	{
+		if (steps[agent] < 0)
+		{
+			printf("%d %d unsolvable\n", starts[agent].X, starts[agent].Y);
+			continue;
+		}
+
+		printf("%d %d %d", starts[agent].X, starts[agent].Y, steps[agent]);
+
+		// Follow the falling distances down to the destination
+		if (printRoutes)
+		{
+			COORD currentCoord = starts[agent];
+			printf(" ");
+
+			for (int step = 0; step < steps[agent]; step++)
+			{
+				int direction = getBatchDirection(distances, dimension, currentCoord);
+
+				printf("%c", directionLetters[direction]);
+				currentCoord.X += directionOffsets[direction].X;
+				currentCoord.Y += directionOffsets[direction].Y;
+			}
+		}
+
+		printf("\n");
+	}
+
+	printf("Solved %d agents in %llums\n", agentCount, elapsed);
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		free(field[index]);
+	}
+
+	free(field);
+	free(starts);
+	free(steps);
+	free(distances);
+
+	return 0;
+}
+
+/// <summary>
+/// Shortest way from many start positions at once through one shared maze.
+/// All agents look for the same destinations, so one breadth-first wave runs backwards from the destinations
+/// and stores the distance in every cell. Each agent then only reads the distance of its start position.
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1 and X</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="starts">start position of every agent</param>
+/// <param name="agentCount">count of the agents</param>
+/// <param name="steps">steps to the nearest destination per agent, -1 if there is no way or the start is not valid</param>
+/// <returns>Dynamically array with the distance of every cell to the nearest destination, -1 for walls and closed areas</returns>
+int* solveBatch(char** field, COORD dimension, COORD* starts, int agentCount, int* steps)
+{
+	int cellCount = dimension.X * dimension.Y;
+	int* distances = (int*)malloc(cellCount * sizeof(int));
+	int* queue = (int*)malloc(cellCount * sizeof(int));
+
+	if (distances == NULL || queue == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	int queueHead = 0;
+	int queueTail = 0;
+
+	// Walls and the border are never entered, every destination starts the wave
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
+			int cell = indexY * dimension.X + indexX;
+			distances[cell] = -1;
+
+			if (field[indexY][indexX] == 'X')
+			{
+				distances[cell] = 0;
+				queue[queueTail] = cell;
+				queueTail++;
+			}
+		}
+	}
+
+	while (queueHead < queueTail)
+	{
+		int cell = queue[queueHead];
+		queueHead++;
+
+		int indexX = cell % dimension.X;
+		int indexY = cell / dimension.X;
+
+		for (int direction = 0; direction < 4; direction++)
+		{
+			int nextX = indexX + directionOffsets[direction].X;
+			int nextY = indexY + directionOffsets[direction].Y;
+
+			// An open border is not part of the maze
+			if (nextX <= 0 || nextY <= 0 || nextX >= dimension.X - 1 || nextY >= dimension.Y - 1)
+				continue;
+
+			int neighbour = nextY * dimension.X + nextX;
+
+			if (distances[neighbour] >= 0 || isPassable(field[nextY][nextX]) != TRUE)
+				continue;
+
+			distances[neighbour] = distances[cell] + 1;
+			queue[queueTail] = neighbour;
+			queueTail++;
+		}
+	}
+
+	free(queue);
+
+	for (int agent = 0; agent < agentCount; agent++)
+	{
+		COORD start = starts[agent];
+		steps[agent] = -1;
+
+		if (start.X >= 0 && start.Y >= 0 && start.X < dimension.X && start.Y < dimension.Y)
+			steps[agent] = distances[start.Y * dimension.X + start.X];
+	}
+
+	return distances;
+}
+
+/// <summary>
+/// Next step of an agent towards the destination, in the ranking Down, Right, Up, Left
+/// </summary>
+/// <param name="distances">of every cell to the nearest destination</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="currentCoord">present position of the agent, must not be a destination</param>
+/// <returns>Index of the direction in directionOffsets</returns>
+int getBatchDirection(int* distances, COORD dimension, COORD currentCoord)
+{
+	int distance = distances[currentCoord.Y * dimension.X + currentCoord.X];
+
+	for (int direction = 0; direction < 4; direction++)
+	{
+		int nextX = currentCoord.X + directionOffsets[direction].X;
+		int nextY = currentCoord.Y + directionOffsets[direction].Y;
+
+		if (distances[nextY * dimension.X + nextX] == distance - 1)
+			return direction;
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// Cheapest way to a destination with Dijkstra's algorithm. The costs of a step are small integers,
+/// so the priority queue is a ring of buckets, one per cost (Dial's algorithm), instead of a heap.
+/// Every cell is settled at most once and each bucket is read in order, so the run time is near linear.
+/// </summary>
+/// <param name="elementField">content of the maze with all types and terrain costs</param>
+/// <param name="field">the scratch maze, to classify elements of the on-demand mode</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="path">receives the cheapest way from source to destination, can be NULL</param>
+/// <param name="checkpoint">not used, the buckets have no tags to keep</param>
+/// <returns>Status, the settled cells as steps, the steps and the cost of the way</returns>
+solveResult dijkstra(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint)
+{
+	solveResult result = { 0 };
+	long long cellCount = (long long)dimension.X * dimension.Y;
+
+	// Cost of every reached cell and the direction it was reached from, costs are only valid for reached cells
+	long long* costs = (long long*)malloc((size_t)cellCount * sizeof(long long));
+	unsigned char* arrivals = (unsigned char*)malloc((size_t)cellCount);
+	costBucket buckets[DIJKSTRA_BUCKETS] = { 0 };
+
+	if (costs == NULL || arrivals == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	memset(arrivals, DIJKSTRA_UNREACHED, (size_t)cellCount);
+
+	long long startCell = (long long)startPosition.Y * dimension.X + startPosition.X;
+	long long destinationCell = -1;
+	long long queued = 1;
+
+	INSTR_PHASE_BEGIN(PhaseSolve);
+	classifyNeighbours(elementField, field, dimension, startPosition);
+
+	costs[startCell] = 0;
+	arrivals[startCell] = DIJKSTRA_SOURCE;
+	pushCostBucket(&buckets[0], startCell);
+
+	for (long long currentCost = 0; queued > 0 && destinationCell < 0; currentCost++)
+	{
+		costBucket* bucket = &buckets[currentCost % DIJKSTRA_BUCKETS];
+
+		// Every step costs at least 1, so no cell is added to the bucket which is read right now
+		for (long long entry = 0; entry < bucket->count; entry++)
+		{
+			long long cell = bucket->cells[entry];
+
+			// Cells which got cheaper afterwards are still in the older bucket
+			if (costs[cell] != currentCost)
+				continue;
+
+			int indexX = (int)(cell % dimension.X);
+			int indexY = (int)(cell / dimension.X);
+
+			result.steps++;
+			INSTR_COUNT(steps);
+
+			if (elementField[indexY][indexX].type == Destination)
+			{
+				destinationCell = cell;
+				break;
+			}
+
+			for (int direction = 0; direction < 4; direction++)
+			{
+				int nextX = indexX + directionOffsets[direction].X;
+				int nextY = indexY + directionOffsets[direction].Y;
+
+				if (nextX < 0 || nextY < 0 || nextX >= dimension.X || nextY >= dimension.Y)
+					continue;
+
+				if (elementField[nextY][nextX].classified != TRUE)
+				{
+					COORD nextCoord = { (SHORT)nextX, (SHORT)nextY };
+					classifyElement(elementField, field, dimension, nextCoord);
+				}
+
+				if (elementField[nextY][nextX].type == Wall)
+					continue;
+
+				long long neighbour = (long long)nextY * dimension.X + nextX;
+				long long nextCost = currentCost + elementField[nextY][nextX].cost;
+
+				if (arrivals[neighbour] == DIJKSTRA_UNREACHED || nextCost < costs[neighbour])
+				{
+					costs[neighbour] = nextCost;
+					arrivals[neighbour] = (unsigned char)direction;
+					pushCostBucket(&buckets[nextCost % DIJKSTRA_BUCKETS], neighbour);
+					queued++;
+				}
+			}
+		}
+
+		queued -= bucket->count;
+		bucket->count = 0;
+	}
+
+	INSTR_PHASE_END(PhaseSolve);
+
+	if (destinationCell < 0)
+	{
+		result.status = SolveNoSolution;
+	}
+	else
+	{
+		INSTR_PHASE_BEGIN(PhasePath);
+
+		// Follow the arrivals back to the source, the way is recorded backwards like the way back of the Tremaux' solvers
+		COORD currentCoord = { (SHORT)(destinationCell % dimension.X), (SHORT)(destinationCell / dimension.X) };
+
+		result.status = SolveFound;
+		result.destination = currentCoord;
+		result.cost = costs[destinationCell];
+
+		if (path != NULL)
+			path->length = 0;
+
+		for (long long cell = destinationCell; arrivals[cell] != DIJKSTRA_SOURCE;
+			cell = (long long)currentCoord.Y * dimension.X + currentCoord.X)
+		{
+			int direction = arrivals[cell];
+
+			if (path != NULL)
+				appendPathMove(path, (direction + 2) & 3);
+
+			currentCoord.X -= directionOffsets[direction].X;
+			currentCoord.Y -= directionOffsets[direction].Y;
+			result.stepsBack++;
+			INSTR_COUNT(wayBackSteps);
+		}
+
+		if (path != NULL)
+			reversePath(path, startPosition, directionOpposite);
+
+		INSTR_PHASE_END(PhasePath);
+	}
+
+	for (int bucket = 0; bucket < DIJKSTRA_BUCKETS; bucket++)
+	{
+		free(buckets[bucket].cells);
+	}
+
+	free(costs);
+	free(arrivals);
+
+	return result;
+}
+
+/// <summary>
+/// Add a cell to a bucket of the Dijkstra queue, the memory grows when needed
+/// </summary>
+/// <param name="bucket">of all cells with the same cost</param>
+/// <param name="cell">index of the cell, row by row</param>
+void pushCostBucket(costBucket* bucket, long long cell)
+{
+	if (bucket->count == bucket->capacity)
+	{
+		bucket->capacity = bucket->capacity == 0 ? BATCH_CAPACITY : bucket->capacity * 2;
+		bucket->cells = (long long*)realloc(bucket->cells, (size_t)bucket->capacity * sizeof(long long));
+
+		if (bucket->cells == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
+	}
+
+	bucket->cells[bucket->count] = cell;
+	bucket->count++;
+}
+
+/// <summary>
+/// Check if a character of the text form can be entered, a corridor or a corridor with terrain cost
+/// </summary>
+/// <param name="character">of the text form</param>
+/// <returns>True for 0 and the cost digits 2 to 9</returns>
+bool isPassable(char character)
+{
+	return character == '0' || (character >= '2' && character <= '0' + TERRAIN_COST_MAX);
+}
+
+/// <summary>
+/// Cost to enter an element of the text form
+/// </summary>
+/// <param name="character">of the text form</param>
+/// <returns>The digit for the cost digits 2 to 9, 1 for corridors and destinations, 0 for walls</returns>
+unsigned char getTerrainCost(char character)
+{
+	if (character >= '2' && character <= '0' + TERRAIN_COST_MAX)
+		return (unsigned char)(character - '0');
+
+	return character == '1' ? 0 : 1;
+}
+
+// Instantiations of the solver policies, DRUL_first_3 are the rules of the console solver
+#define POLICY_NAME DRUL_first_3
+#define POLICY_ORDER 0, 1, 2, 3
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME DRUL_first_2
+#define POLICY_ORDER 0, 1, 2, 3
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 2
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME DRUL_last_3
+#define POLICY_ORDER 0, 1, 2, 3
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME RULD_first_3
+#define POLICY_ORDER 1, 2, 3, 0
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME RULD_last_3
+#define POLICY_ORDER 1, 2, 3, 0
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME ULDR_first_3
+#define POLICY_ORDER 2, 3, 0, 1
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME ULDR_last_3
+#define POLICY_ORDER 2, 3, 0, 1
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME LDRU_first_3
+#define POLICY_ORDER 3, 0, 1, 2
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME LDRU_last_3
+#define POLICY_ORDER 3, 0, 1, 2
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME DLUR_first_3
+#define POLICY_ORDER 0, 3, 2, 1
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME DLUR_last_3
+#define POLICY_ORDER 0, 3, 2, 1
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME LURD_first_3
+#define POLICY_ORDER 3, 2, 1, 0
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME LURD_last_3
+#define POLICY_ORDER 3, 2, 1, 0
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME URDL_first_3
+#define POLICY_ORDER 2, 1, 0, 3
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME URDL_last_3
+#define POLICY_ORDER 2, 1, 0, 3
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME RDLU_first_3
+#define POLICY_ORDER 1, 0, 3, 2
+#define POLICY_TIE_LAST FALSE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+
+#define POLICY_NAME RDLU_last_3
+#define POLICY_ORDER 1, 0, 3, 2
+#define POLICY_TIE_LAST TRUE
+#define POLICY_LIMIT 3
+#include "TremauxPolicy.h"
+// Registry of all solver policies for benchmarking
+static const solverPolicy solverPolicies[] =
+{
+	{ "DRUL-first-3", tremaux_DRUL_first_3, tremauxOnDemand_DRUL_first_3, FALSE },
+	{ "DRUL-first-2", tremaux_DRUL_first_2, tremauxOnDemand_DRUL_first_2, FALSE },
+	{ "DRUL-last-3", tremaux_DRUL_last_3, tremauxOnDemand_DRUL_last_3, FALSE },
+	{ "RULD-first-3", tremaux_RULD_first_3, tremauxOnDemand_RULD_first_3, FALSE },
+	{ "RULD-last-3", tremaux_RULD_last_3, tremauxOnDemand_RULD_last_3, FALSE },
+	{ "ULDR-first-3", tremaux_ULDR_first_3, tremauxOnDemand_ULDR_first_3, FALSE },
+	{ "ULDR-last-3", tremaux_ULDR_last_3, tremauxOnDemand_ULDR_last_3, FALSE },
+	{ "LDRU-first-3", tremaux_LDRU_first_3, tremauxOnDemand_LDRU_first_3, FALSE },
+	{ "LDRU-last-3", tremaux_LDRU_last_3, tremauxOnDemand_LDRU_last_3, FALSE },
+	{ "DLUR-first-3", tremaux_DLUR_first_3, tremauxOnDemand_DLUR_first_3, FALSE },
+	{ "DLUR-last-3", tremaux_DLUR_last_3, tremauxOnDemand_DLUR_last_3, FALSE },
+	{ "LURD-first-3", tremaux_LURD_first_3, tremauxOnDemand_LURD_first_3, FALSE },
+	{ "LURD-last-3", tremaux_LURD_last_3, tremauxOnDemand_LURD_last_3, FALSE },
+	{ "URDL-first-3", tremaux_URDL_first_3, tremauxOnDemand_URDL_first_3, FALSE },
+	{ "URDL-last-3", tremaux_URDL_last_3, tremauxOnDemand_URDL_last_3, FALSE },
+	{ "RDLU-first-3", tremaux_RDLU_first_3, tremauxOnDemand_RDLU_first_3, FALSE },
+	{ "RDLU-last-3", tremaux_RDLU_last_3, tremauxOnDemand_RDLU_last_3, FALSE },
+	{ "dijkstra", dijkstra, dijkstra, TRUE }
+};
+
+#define SOLVER_POLICY_COUNT ((int)(sizeof(solverPolicies) / sizeof(solverPolicies[0])))
+
+/// <summary>
+/// Command line to compare all solver policies on one maze:
+/// policies <maze> [X Y]
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when all policies were run</returns>
+int runPolicies(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s policies <maze> [X Y]\n", argv[0]);
+		return 1;
+	}
+
+	COORD startPosition = { 1, 1 };
+
+	if (argc > 4)
+	{
+		startPosition.X = (SHORT)atoi(argv[3]);
+		startPosition.Y = (SHORT)atoi(argv[4]);
+	}
+
+	COORD dimension = { 0 };
+	char** field = scanFieldFromPath(argv[2], &dimension);
+
+	if (field == NULL || validateStartPosition(field, dimension, startPosition) != TRUE)
+		return 1;
+
+	element** mazeContent = getMazeContent(dimension, field);
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	printf("%-16s %-12s %12s %12s %12s %12s\n", "policy", "status", "steps", "steps back", "cost", "ms");
+
+	for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
+	{
+		solveResult result = { 0 };
+		long long bestTicks = LLONG_MAX;
+
+		// Take the fastest of some runs, every run starts without tags
+		for (int repeat = 0; repeat < POLICY_BENCH_REPEAT; repeat++)
+		{
+			LARGE_INTEGER startTicks;
+			LARGE_INTEGER endTicks;
+
+			resetMazeContent(mazeContent, dimension);
+
+			QueryPerformanceCounter(&startTicks);
+			result = solverPolicies[policy].solve(mazeContent, field, dimension, startPosition, NULL, NULL);
+			QueryPerformanceCounter(&endTicks);
+
+			if (endTicks.QuadPart - startTicks.QuadPart < bestTicks)
+				bestTicks = endTicks.QuadPart - startTicks.QuadPart;
+		}
+
+		printf("%-16s %-12s %12lld %12lld %12lld %12.3f\n", solverPolicies[policy].name, solveStatusNames[result.status],
+			result.steps, result.stepsBack, result.cost, (double)bestTicks * 1000.0 / (double)frequency.QuadPart);
+	}
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		free(mazeContent[index]);
+		free(field[index]);
+	}
+
+	free(mazeContent);
+	free(field);
+
+	return 0;
+}
+
+/// <summary>
+/// Clear all tags, so the maze content can be solved again
+/// </summary>
+/// <param name="elementField">content of the maze with all types</param>
+/// <param name="dimension">of the maze in coordination</param>
+void resetMazeContent(element** elementField, COORD dimension)
+{
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
+			elementField[indexY][indexX].markOne = FALSE;
+			elementField[indexY][indexX].markTwo = FALSE;
+		}
+	}
+}
+
+/// <summary>
+/// Command line to solve a maze without console output and export the results:
+/// solve <maze> [X Y] [-policy name] [-export prefix] [-cache directory] [-nocache] [-lazy] [-checkpoint file] [-every steps|seconds s] [-resume]
+/// Results are looked up in the cache before the maze is read, a solve with export always runs to get the tagged maze
+/// and a solve with checkpoint always runs, so its checkpoint is resumed or removed.
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when the maze was solved</returns>
+int runSolve(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s solve <maze> [X Y] [-policy name] [-export prefix] [-cache directory] [-nocache] [-lazy] [-checkpoint file] [-every steps|seconds s] [-resume]\n", argv[0]);
+		return 1;
+	}
+
+	COORD startPosition = { 1, 1 };
+	char* policyName = SOLVE_DEFAULT_POLICY;
+	char* exportPrefix = NULL;
+	char* cacheDirectory = CACHE_DIRECTORY;
+	char* checkpointName = NULL;
+	long long stepInterval = 0;
+	unsigned long long timeInterval = CHECKPOINT_SECONDS * 1000ULL;
+	bool isOnDemand = FALSE;
+	bool isResume = FALSE;
+
+	for (int index = 3; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-policy") == 0 && index + 1 < argc)
+			policyName = argv[++index];
+		else if (strcmp(argv[index], "-export") == 0 && index + 1 < argc)
+			exportPrefix = argv[++index];
+		else if (strcmp(argv[index], "-checkpoint") == 0 && index + 1 < argc)
+			checkpointName = argv[++index];
+		else if (strcmp(argv[index], "-resume") == 0)
+			isResume = TRUE;
+		else if (strcmp(argv[index], "-every") == 0 && index + 1 < argc)
+		{
+			// A number with s is the interval in seconds, otherwise in steps
+			char* unit = NULL;
+			double interval = strtod(argv[++index], &unit);
+			bool isSeconds = strcmp(unit, "s") == 0;
+
+			if (unit == argv[index] || (*unit != '\0' && isSeconds != TRUE) || !(interval >= (isSeconds ? 0.001 : 1.0))
+				|| interval > (double)LLONG_MAX / 1000.0)
+			{
+				printf("Error - %s is no interval of at least one step or one millisecond\n", argv[index]);
+				return 1;
+			}
+
+			if (isSeconds)
+				timeInterval = (unsigned long long)(interval * 1000.0);
+			else
+				stepInterval = (long long)interval;
+		}
+		else if (strcmp(argv[index], "-cache") == 0 && index + 1 < argc)
+			cacheDirectory = argv[++index];
+		else if (strcmp(argv[index], "-nocache") == 0)
+			cacheDirectory = NULL;
+		else if (strcmp(argv[index], "-lazy") == 0)
+			isOnDemand = TRUE;
+		else if (index + 1 < argc && argv[index][0] != '-')
+		{
+			startPosition.X = (SHORT)atoi(argv[index]);
+			startPosition.Y = (SHORT)atoi(argv[++index]);
+		}
+		else
+		{
+			printf("Error - unknown solve option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	int policy = findSolverPolicy(policyName);
+
+	if (policy < 0)
+	{
+		printf("Error - there is no solver policy %s\n", policyName);
+		return 1;
+	}
+
+	// Only the Tremaux' policies have tags to keep
+	if ((checkpointName != NULL && solverPolicies[policy].solve == dijkstra) || (isResume && checkpointName == NULL))
+	{
+		printf("Error - checkpoints need -checkpoint file and a Tremaux' policy\n");
+		return 1;
+	}
+
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER hashTicks;
+	LARGE_INTEGER startTicks;
+	LARGE_INTEGER solveTicks;
+	LARGE_INTEGER exportTicks;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&hashTicks);
+
+	// Look up the cache before any preprocessing, a hit costs only one pass over the file
+	char entryName[FILENAME_MAX];
+	unsigned long long fileHash = 0;
+	packedPath path = { PATH_MOVE_BITS };
+	solveResult result = { 0 };
+
+	// The checkpoint needs the hash as well, so it is only resumed with the same maze
+	bool isHashed = (cacheDirectory != NULL || checkpointName != NULL) && hashMazeFile(argv[2], &fileHash);
+
+	if (checkpointName != NULL && isHashed != TRUE)
+	{
+		printf("Error - can not read the maze %s\n", argv[2]);
+		return 1;
+	}
+
+	if (cacheDirectory != NULL && isHashed)
+	{
+		getCacheEntryName(entryName, cacheDirectory, fileHash, startPosition, solverPolicies[policy].name);
+
+		if (exportPrefix == NULL && checkpointName == NULL && readCacheEntry(entryName, fileHash, startPosition, solverPolicies[policy].name, &result, &path))
+		{
+			QueryPerformanceCounter(&startTicks);
+
+			printSolveResult(solverPolicies[policy].name, result, &path);
+			printf("Cache hit %s, hash %.3fms\n", entryName,
+				(double)(startTicks.QuadPart - hashTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+			free(path.moves);
+			return result.status == SolveFound ? 0 : 1;
+		}
+	}
+	else
+	{
+		cacheDirectory = NULL;
+	}
+
+	COORD dimension = { 0 };
+	INSTR_PHASE_BEGIN(PhaseLoad);
+	char** field = scanFieldFromPath(argv[2], &dimension);
+	INSTR_PHASE_END(PhaseLoad);
+
+	if (field == NULL || validateStartPosition(field, dimension, startPosition) != TRUE)
+		return 1;
+
+	QueryPerformanceCounter(&startTicks);
+
+	// The classification is part of the solve time, with -lazy it only covers the visited area
+	INSTR_PHASE_BEGIN(PhaseClassify);
+	element** mazeContent = isOnDemand ? getMazeContentOnDemand(dimension) : getMazeContent(dimension, field);
+	INSTR_PHASE_END(PhaseClassify);
+	solveCheckpoint* checkpoint = NULL;
+
+	if (checkpointName != NULL)
+	{
+		checkpoint = createCheckpoint(checkpointName, fileHash, solverPolicies[policy].name, dimension, stepInterval, timeInterval);
+
+		if (isResume)
+		{
+			if (readCheckpoint(checkpoint, mazeContent, dimension, startPosition) != TRUE)
+			{
+				freeCheckpoint(checkpoint);
+
+				for (int index = 0; index < dimension.Y; index++)
+				{
+					if (isOnDemand != TRUE || index == 0)
+						free(mazeContent[index]);
+
+					free(field[index]);
+				}
+
+				free(mazeContent);
+				free(field);
+				return 1;
+			}
+
+			printf("Resumed at step %lld\n", checkpoint->steps);
+		}
+	}
+
+	policySolver solve = isOnDemand ? solverPolicies[policy].solveOnDemand : solverPolicies[policy].solve;
+	result = solve(mazeContent, field, dimension, startPosition, &path, checkpoint);
+
+	QueryPerformanceCounter(&solveTicks);
+
+	bool isExported = TRUE;
+
+	if (result.status == SolveFound && exportPrefix != NULL)
+	{
+		isExported = exportPath(exportPrefix, &path, squareMoveNames) && exportSolvedMaze(exportPrefix, mazeContent, field, dimension, &path);
+	}
+
+	QueryPerformanceCounter(&exportTicks);
+
+	printSolveResult(solverPolicies[policy].name, result, &path);
+	printf("Solve %.3fms, export %.3fms\n",
+		(double)(solveTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart,
+		(double)(exportTicks.QuadPart - solveTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+	// The solve is complete, so its checkpoint is not needed any more
+	if (checkpoint != NULL)
+	{
+		printf("Checkpoints %d, %.3fms\n", checkpoint->writeCount, checkpoint->writeMilliseconds);
+		DeleteFileA(checkpointName);
+		freeCheckpoint(checkpoint);
+	}
+
+	// Unsolvable verdicts are stored as well, so they are not searched again
+	if (cacheDirectory != NULL && writeCacheEntry(entryName, cacheDirectory, fileHash, startPosition, solverPolicies[policy].name, result, &path))
+	{
+		evictCacheEntries(cacheDirectory, CACHE_SIZE_LIMIT);
+		printf("Cache stored %s\n", entryName);
+	}
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		// The on-demand content is one block, which starts at the first row
+		if (isOnDemand != TRUE || index == 0)
+			free(mazeContent[index]);
+
+		free(field[index]);
+	}
+
+	free(mazeContent);
+	free(field);
+	free(path.moves);
+
+	INSTR_EXPORT();
+
+	return result.status == SolveFound && isExported ? 0 : 1;
+}
+
+/// <summary>
+/// Create the checkpoint of a headless solve with empty bitplanes
+/// </summary>
+/// <param name="fileName">of the checkpoint file</param>
+/// <param name="fileHash">of the maze file, a checkpoint is only resumed with the same maze</param>
+/// <param name="policyName">name of the solver policy</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="stepInterval">steps between two checkpoints, 0 to use the interval of time</param>
+/// <param name="timeInterval">milliseconds between two checkpoints</param>
+/// <returns>Checkpoint which is first written after the interval</returns>
+solveCheckpoint* createCheckpoint(char* fileName, unsigned long long fileHash, const char* policyName, COORD dimension, long long stepInterval, unsigned long long timeInterval)
+{
+	solveCheckpoint* checkpoint = (solveCheckpoint*)calloc(1, sizeof(solveCheckpoint));
+
+	if (checkpoint == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	checkpoint->fileName = fileName;
+	checkpoint->fileHash = fileHash;
+	checkpoint->policyName = policyName;
+	checkpoint->planeWords = ((long long)dimension.X * dimension.Y + 63) / 64;
+	checkpoint->stepInterval = stepInterval;
+	checkpoint->timeInterval = timeInterval;
+	checkpoint->nextSteps = stepInterval > 0 ? stepInterval : CHECKPOINT_CHECK_STEPS;
+	checkpoint->nextTime = GetTickCount64() + timeInterval;
+
+	for (int plane = 0; plane < 2; plane++)
+	{
+		checkpoint->planes[plane] = (unsigned long long*)calloc((size_t)checkpoint->planeWords, sizeof(unsigned long long));
+
+		if (checkpoint->planes[plane] == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
+	}
+
+	return checkpoint;
+}
+
+/// <summary>
+/// Free the checkpoint and its bitplanes, the file stays
+/// </summary>
+/// <param name="checkpoint">to free</param>
+void freeCheckpoint(solveCheckpoint* checkpoint)
+{
+	free(checkpoint->planes[0]);
+	free(checkpoint->planes[1]);
+	free(checkpoint);
+}
+
+/// <summary>
+/// Keep a new tag of an element in the bitplane of the tag
+/// </summary>
+/// <param name="checkpoint">of the solve</param>
+/// <param name="plane">0 for markOne, 1 for markTwo</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">tagged element</param>
+void markCheckpoint(solveCheckpoint* checkpoint, int plane, COORD dimension, COORD coord)
+{
+	long long cell = (long long)coord.Y * dimension.X + coord.X;
+
+	checkpoint->planes[plane][cell >> 6] |= 1ULL << (cell & 63);
+}
+
+/// <summary>
+/// Called by the solver when the steps reach nextSteps: write the checkpoint when the interval is over
+/// </summary>
+/// <param name="checkpoint">of the solve</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="currentCoord">position where the solver continues</param>
+/// <param name="latestCoord">position before the current position</param>
+/// <param name="steps">counted so far</param>
+void saveCheckpoint(solveCheckpoint* checkpoint, COORD dimension, COORD startPosition, COORD currentCoord, COORD latestCoord, long long steps)
+{
+	// With an interval of time only every CHECKPOINT_CHECK_STEPS steps read the clock
+	if (checkpoint->stepInterval > 0)
+	{
+		checkpoint->nextSteps = steps + checkpoint->stepInterval;
+	}
+	else
+	{
+		checkpoint->nextSteps = steps + CHECKPOINT_CHECK_STEPS;
+
+		if (GetTickCount64() < checkpoint->nextTime)
+			return;
+	}
+
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER startTicks;
+	LARGE_INTEGER endTicks;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&startTicks);
+
+	checkpoint->currentCoord = currentCoord;
+	checkpoint->latestCoord = latestCoord;
+	checkpoint->steps = steps;
+
+	// A failed checkpoint keeps the last one, the solve goes on
+	if (writeCheckpoint(checkpoint, dimension, startPosition))
+		checkpoint->writeCount++;
+
+	QueryPerformanceCounter(&endTicks);
+	checkpoint->writeMilliseconds += (double)(endTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart;
+	checkpoint->nextTime = GetTickCount64() + checkpoint->timeInterval;
+}
+
+/// <summary>
+/// Write the checkpoint into a temporary file, which replaces the last checkpoint only when it is complete.
+/// An interrupted write never leaves a broken checkpoint.
+/// </summary>
+/// <param name="checkpoint">positions, steps and bitplanes to write</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <returns>True when the checkpoint was replaced</returns>
+bool writeCheckpoint(solveCheckpoint* checkpoint, COORD dimension, COORD startPosition)
+{
+	char temporaryName[FILENAME_MAX];
+	FILE* file;
+
+	snprintf(temporaryName, FILENAME_MAX, "%s.tmp", checkpoint->fileName);
+
+	if (fopen_s(&file, temporaryName, "wb") != 0)
+	{
+		printf("Error - can not write the checkpoint %s\n", temporaryName);
+		return FALSE;
+	}
+
+	checkpointHeader header = { 0 };
+
+	memcpy(header.magic, CHECKPOINT_MAGIC, PACKED_MAGIC_SIZE);
+	strncpy_s(header.policy, CACHE_POLICY_NAME, checkpoint->policyName, _TRUNCATE);
+	header.fileHash = checkpoint->fileHash;
+	header.dimension[0] = dimension.X;
+	header.dimension[1] = dimension.Y;
+	header.start[0] = startPosition.X;
+	header.start[1] = startPosition.Y;
+	header.current[0] = checkpoint->currentCoord.X;
+	header.current[1] = checkpoint->currentCoord.Y;
+	header.latest[0] = checkpoint->latestCoord.X;
+	header.latest[1] = checkpoint->latestCoord.Y;
+	header.steps = checkpoint->steps;
+
+	fwrite(&header, sizeof(checkpointHeader), 1, file);
+	fwrite(checkpoint->planes[0], sizeof(unsigned long long), (size_t)checkpoint->planeWords, file);
+	fwrite(checkpoint->planes[1], sizeof(unsigned long long), (size_t)checkpoint->planeWords, file);
+
+	// MOVEFILE_WRITE_THROUGH only makes the rename durable, so the data is on the disk before the name points to it
+	bool isWritten = fflush(file) == 0 && _commit(_fileno(file)) == 0 && ferror(file) == 0;
+	fclose(file);
+
+	if (isWritten != TRUE || MoveFileExA(temporaryName, checkpoint->fileName, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == FALSE)
+	{
+		printf("Error - can not store the checkpoint %s\n", checkpoint->fileName);
+		DeleteFileA(temporaryName);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Read a checkpoint of the same maze, start position and policy, and set its tags in the maze content.
+/// The solver continues with the positions and the steps of the checkpoint.
+/// </summary>
+/// <param name="checkpoint">receives positions, steps and bitplanes</param>
+/// <param name="elementField">content of the maze, the tags must be cleared</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <returns>True when the checkpoint belongs to this solve</returns>
+bool readCheckpoint(solveCheckpoint* checkpoint, element** elementField, COORD dimension, COORD startPosition)
+{
+	FILE* file;
+
+	if (fopen_s(&file, checkpoint->fileName, "rb") != 0)
+	{
+		printf("Error - can not open the checkpoint %s\n", checkpoint->fileName);
+		return FALSE;
+	}
+
+	checkpointHeader header = { 0 };
+	bool isValid = fread(&header, sizeof(checkpointHeader), 1, file) == 1
+		&& memcmp(header.magic, CHECKPOINT_MAGIC, PACKED_MAGIC_SIZE) == 0
+		&& header.fileHash == checkpoint->fileHash
+		&& strncmp(header.policy, checkpoint->policyName, CACHE_POLICY_NAME) == 0
+		&& header.dimension[0] == dimension.X && header.dimension[1] == dimension.Y
+		&& header.start[0] == startPosition.X && header.start[1] == startPosition.Y
+		&& header.current[0] > 0 && header.current[1] > 0 && header.current[0] < dimension.X - 1 && header.current[1] < dimension.Y - 1
+		&& abs(header.latest[0] - header.current[0]) + abs(header.latest[1] - header.current[1]) <= 1
+		&& header.steps > 0 && header.steps <= (long long)dimension.X * dimension.Y * SOLVER_STEP_LIMIT_FACTOR
+		&& fread(checkpoint->planes[0], sizeof(unsigned long long), (size_t)checkpoint->planeWords, file) == (size_t)checkpoint->planeWords
+		&& fread(checkpoint->planes[1], sizeof(unsigned long long), (size_t)checkpoint->planeWords, file) == (size_t)checkpoint->planeWords;
+
+	fclose(file);
+
+	if (isValid != TRUE)
+	{
+		printf("Error - %s is no checkpoint of this maze, start position and policy\n", checkpoint->fileName);
+		return FALSE;
+	}
+
+	// Only the few tagged elements are visited, the words without any tag are skipped at once
+	for (int plane = 0; plane < 2; plane++)
+	{
+		for (long long word = 0; word < checkpoint->planeWords; word++)
+		{
+			unsigned long long bits = checkpoint->planes[plane][word];
+
+			for (long long cell = word * 64; bits != 0; cell++, bits >>= 1)
+			{
+				if ((bits & 1) == 0)
+					continue;
+
+				element* content = &elementField[cell / dimension.X][cell % dimension.X];
+
+				if (plane == 0)
+					content->markOne = TRUE;
+				else
+					content->markTwo = TRUE;
+			}
+		}
+	}
+
+	checkpoint->isResumed = TRUE;
+	checkpoint->currentCoord.X = (SHORT)header.current[0];
+	checkpoint->currentCoord.Y = (SHORT)header.current[1];
+	checkpoint->latestCoord.X = (SHORT)header.latest[0];
+	checkpoint->latestCoord.Y = (SHORT)header.latest[1];
+	checkpoint->steps = header.steps;
+	checkpoint->nextSteps = checkpoint->steps + (checkpoint->stepInterval > 0 ? checkpoint->stepInterval : CHECKPOINT_CHECK_STEPS);
+
+	return TRUE;
+}
+
+/// <summary>
+/// Print the result of a headless solve and the way as run-length moves when it is short
+/// </summary>
+/// <param name="policyName">name of the solver policy</param>
+/// <param name="result">status and count of steps</param>
+/// <param name="path">packed way from source to destination</param>
+void printSolveResult(const char* policyName, solveResult result, packedPath* path)
+{
+	printf("Policy %s: %s after %lld steps, shortest way back in %lld steps with cost %lld\n", policyName,
+		solveStatusNames[result.status], result.steps, result.stepsBack, result.cost);
+
+	if (result.status == SolveFound && path->length <= SOLVE_PRINT_ROUTE_MAX)
+	{
+		char* route = encodePathRunLength(path, squareMoveNames);
+		printf("Route: %s\n", route);
+		free(route);
+	}
+}
+
+/// <summary>
+/// Check the start position of a solver without console output
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1 and X</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">X and Y of start position</param>
+/// <returns>True when the start position is a corridor inside the maze</returns>
+bool validateStartPosition(char** field, COORD dimension, COORD startPosition)
+{
+	if (startPosition.X <= 0 || startPosition.Y <= 0 || startPosition.X >= dimension.X - 1 || startPosition.Y >= dimension.Y - 1
+		|| isPassable(field[startPosition.Y][startPosition.X]) != TRUE)
+	{
+		printf("Error - start position X:%d Y:%d has to be a corridor inside the maze!\n", startPosition.X, startPosition.Y);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Look up a solver policy by its name in the registry
+/// </summary>
+/// <param name="name">of the policy, e.g. DRUL-first-3</param>
+/// <returns>Index in solverPolicies - returns -1 if there is no policy with this name</returns>
+int findSolverPolicy(char* name)
+{
+	for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
+	{
+		if (strcmp(solverPolicies[policy].name, name) == 0)
+			return policy;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Direction of one step between two neighbours
+/// </summary>
+/// <param name="currentCoord">position before the step</param>
+/// <param name="nextCoord">position after the step</param>
+/// <returns>Index of the direction in directionOffsets</returns>
+int getDirection(COORD currentCoord, COORD nextCoord)
+{
+	if (nextCoord.Y > currentCoord.Y)
+		return 0;
+
+	if (nextCoord.X > currentCoord.X)
+		return 1;
+
+	if (nextCoord.Y < currentCoord.Y)
+		return 2;
+
+	return 3;
+}
+
+/// <summary>
+/// Append one step to the packed way, the memory grows when needed
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="direction">index of the direction</param>
+void appendPathMove(packedPath* path, int direction)
+{
+	if (path->length == path->capacity)
+	{
+		path->capacity = path->capacity == 0 ? PATH_CAPACITY : path->capacity * 2;
+		path->moves = (unsigned char*)realloc(path->moves, (size_t)getPathBytes(path, path->capacity));
+
+		if (path->moves == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
+	}
+
+	setPathMove(path, path->length, direction);
+	path->length++;
+}
+
+/// <summary>
+/// Read one step of the packed way
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="index">of the step</param>
+/// <returns>Index of the direction</returns>
+int getPathMove(packedPath* path, long long index)
+{
+	long long bit = index * path->moveBits;
+
+	return (path->moves[bit >> 3] >> (bit & 7)) & ((1 << path->moveBits) - 1);
+}
+
+/// <summary>
+/// Overwrite one step of the packed way, the steps never cross a byte because moveBits divides eight
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="index">of the step</param>
+/// <param name="direction">index of the direction</param>
+void setPathMove(packedPath* path, long long index, int direction)
+{
+	long long bit = index * path->moveBits;
+	int shift = (int)(bit & 7);
+	int mask = ((1 << path->moveBits) - 1) << shift;
+
+	path->moves[bit >> 3] = (unsigned char)((path->moves[bit >> 3] & ~mask) | (direction << shift));
+}
+
+/// <summary>
+/// Turn a way recorded from the destination into the way from the source
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="startPosition">the source position, where the reversed way begins</param>
+/// <param name="opposite">index of the opposite direction of every direction, e.g. directionOpposite</param>
+void reversePath(packedPath* path, COORD startPosition, const int* opposite)
+{
+	for (long long front = 0, back = path->length - 1; front <= back; front++, back--)
+	{
+		int frontMove = getPathMove(path, front);
+		int backMove = getPathMove(path, back);
+
+		setPathMove(path, front, opposite[backMove]);
+		setPathMove(path, back, opposite[frontMove]);
+	}
+
+	path->start = startPosition;
+}
+
+/// <summary>
+/// Bytes of the first steps of a packed way
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="length">count of steps</param>
+/// <returns>Count of whole bytes which hold the steps</returns>
+long long getPathBytes(packedPath* path, long long length)
+{
+	return (length * path->moveBits + 7) / 8;
+}
+
+/// <summary>
+/// Encode the way as run-length string, e.g. D5R12U3 or D5DR3R12
+/// </summary>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="moveNames">names of the directions, e.g. squareMoveNames</param>
+/// <returns>Dynamically string with the encoded way</returns>
+char* encodePathRunLength(packedPath* path, const char* const* moveNames)
+{
+	// Count the runs first, every run needs at most two letters and 20 digits
+	long long runs = 0;
+
+	for (long long index = 0; index < path->length; index++)
+	{
+		if (index == 0 || getPathMove(path, index) != getPathMove(path, index - 1))
+			runs++;
+	}
+
+	size_t size = (size_t)runs * 22 + TRAILING_ZERO;
+	char* encoded = (char*)malloc(size);
+
+	if (encoded == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	size_t used = 0;
+	encoded[0] = '\0';
+
+	for (long long index = 0; index < path->length;)
+	{
+		int direction = getPathMove(path, index);
+		long long runEnd = index + 1;
+
+		while (runEnd < path->length && getPathMove(path, runEnd) == direction)
+		{
+			runEnd++;
+		}
+
+		used += snprintf(encoded + used, size - used, "%s%lld", moveNames[direction], runEnd - index);
+		index = runEnd;
+	}
+
+	return encoded;
+}
+
+/// <summary>
+/// Write the way as run-length text to prefix.rle and packed to prefix.path, with the magic of its width
+/// </summary>
+/// <param name="fileName">prefix of both files</param>
+/// <param name="path">packed way with moveBits bits per step</param>
+/// <param name="moveNames">names of the directions for the run-length text</param>
+/// <returns>True when both files were written</returns>
+bool exportPath(char* fileName, packedPath* path, const char* const* moveNames)
+{
+	char pathName[FILENAME_MAX];
+	FILE* file;
+
+	// Run-length text
+	snprintf(pathName, FILENAME_MAX, "%s.rle", fileName);
+
+	if (fopen_s(&file, pathName, "wb") != 0)
+	{
+		printf("Error - can not write the way to %s\n", pathName);
+		return FALSE;
+	}
+
+	char* encoded = encodePathRunLength(path, moveNames);
+	fprintf(file, "%d %d %s\n", path->start.X, path->start.Y, encoded);
+	free(encoded);
+
+	bool isWritten = ferror(file) == 0;
+	fclose(file);
+
+	// Packed form: magic, start X and Y, count of steps, four steps per byte with MZP1 and two with MZP2
+	snprintf(pathName, FILENAME_MAX, "%s.path", fileName);
+
+	if (fopen_s(&file, pathName, "wb") != 0)
+	{
+		printf("Error - can not write the way to %s\n", pathName);
+		return FALSE;
+	}
+
+	unsigned int start[2] = { (unsigned int)path->start.X, (unsigned int)path->start.Y };
+	unsigned long long length = (unsigned long long)path->length;
+
+	fwrite(path->moveBits == PATH_MOVE_BITS ? PATH_MAGIC : PATH_WIDE_MAGIC, 1, PACKED_MAGIC_SIZE, file);
+	fwrite(start, sizeof(unsigned int), 2, file);
+	fwrite(&length, sizeof(unsigned long long), 1, file);
+	fwrite(path->moves, 1, (size_t)getPathBytes(path, path->length), file);
+
+	isWritten = isWritten && ferror(file) == 0;
+	fclose(file);
+
+	return isWritten;
+}
+
+/// <summary>
+/// Write the solved maze to prefix.solved.txt in the text form of the maze.
+/// The file is mapped into memory and filled row by row, afterwards the way is drawn in place.
+/// Markers tagged once become +, markers tagged twice #, the way * and the source S.
+/// </summary>
+/// <param name="fileName">prefix of the file</param>
+/// <param name="elementField">content of the maze with all tag values</param>
+/// <param name="field">the scratch maze, untagged elements keep its character</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="path">packed way from source to destination</param>
+/// <returns>True when the file was written</returns>
+bool exportSolvedMaze(char* fileName, element** elementField, char** field, COORD dimension, packedPath* path)
+{
+	char solvedName[FILENAME_MAX];
+	char header[BUFFER_SIZE];
+
+	snprintf(solvedName, FILENAME_MAX, "%s.solved.txt", fileName);
+
+	// Every row has a fixed length, so each element has a known place in the file
+	size_t headerSize = (size_t)snprintf(header, BUFFER_SIZE, "%d %d\n", dimension.X, dimension.Y);
+	size_t rowSize = 2 * (size_t)dimension.X;
+	size_t fileSize = headerSize + rowSize * dimension.Y;
+
+	HANDLE file = CreateFileA(solvedName, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		printf("Error - can not write the solved maze to %s\n", solvedName);
+		return FALSE;
+	}
+
+	LARGE_INTEGER mappingSize;
+	mappingSize.QuadPart = (long long)fileSize;
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)mappingSize.HighPart, mappingSize.LowPart, NULL);
+	char* view = mapping != NULL ? (char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, fileSize) : NULL;
+
+	if (view == NULL)
+	{
+		printf("Error - can not map the solved maze %s\n", solvedName);
+
+		if (mapping != NULL)
+			CloseHandle(mapping);
+
+		CloseHandle(file);
+		return FALSE;
+	}
+
+	memcpy(view, header, headerSize);
+
+	// Character of tagged markers by their tags, all other elements keep the character of the maze,
+	// so terrain costs and elements which were never classified stay as they are
+	static const char taggedCharacters[4] = { '0', '+', '#', '#' };
+
+	// Encode every row into a buffer and copy it in one block
+	char* row = (char*)malloc(rowSize);
+
+	if (row == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	for (int indexX = 0; indexX < dimension.X; indexX++)
+	{
+		row[2 * indexX + 1] = EMPTY_SPACE;
+	}
+
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		element* elements = elementField[indexY];
+
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
+			int tags = elements[indexX].markOne + 2 * elements[indexX].markTwo;
+			row[2 * indexX] = tags == 0 ? field[indexY][indexX] : taggedCharacters[tags];
+		}
+
+		row[rowSize - 1] = '\n';
+		memcpy(view + headerSize + rowSize * indexY, row, rowSize);
+	}
+
+	free(row);
+
+	// Draw the way directly into the mapped file
+	COORD currentCoord = path->start;
+	view[headerSize + rowSize * currentCoord.Y + 2 * currentCoord.X] = 'S';
+
+	for (long long index = 0; index + 1 < path->length; index++)
+	{
+		int direction = getPathMove(path, index);
+
+		currentCoord.X += directionOffsets[direction].X;
+		currentCoord.Y += directionOffsets[direction].Y;
+		view[headerSize + rowSize * currentCoord.Y + 2 * currentCoord.X] = '*';
+	}
+
+	UnmapViewOfFile(view);
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	return TRUE;
+}
+
+/// <summary>
+/// Fast 64 bit hash over all bytes of the maze file, read in large blocks.
+/// Four lanes of 8 bytes are mixed independently, so the multiplications do not wait for each other.
+/// </summary>
+/// <param name="pathToField">Path to the maze file</param>
+/// <param name="fileHash">hash of the file content</param>
+/// <returns>True when the file could be read</returns>
+bool hashMazeFile(char* pathToField, unsigned long long* fileHash)
+{
+	static const unsigned long long primes[4] =
+	{
+		0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x85EBCA77C2B2AE63ULL
+	};
+
+	FILE* file;
+
+	if (fopen_s(&file, pathToField, "rb") != 0)
+		return FALSE;
+
+	// The blocks are read without stdio buffer, every block except the last is a multiple of the 32 byte stripe
+	setvbuf(file, NULL, _IONBF, 0);
+
+	unsigned char* block = (unsigned char*)malloc(CACHE_READ_BLOCK);
+
+	if (block == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	unsigned long long lanes[4] = { primes[0], primes[1], primes[2], primes[3] };
+	unsigned long long totalSize = 0;
+	unsigned long long tail = 0;
+	size_t blockSize;
+
+	while ((blockSize = fread(block, 1, CACHE_READ_BLOCK, file)) > 0)
+	{
+		size_t stripes = blockSize & ~(size_t)31;
+
+		for (size_t offset = 0; offset < stripes; offset += 32)
+		{
+			unsigned long long words[4];
+			memcpy(words, block + offset, sizeof(words));
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				unsigned long long value = lanes[lane] + words[lane] * primes[1];
+				lanes[lane] = ((value << 31) | (value >> 33)) * primes[0];
+			}
+		}
+
+		// Only the last block can end inside a stripe
+		for (size_t offset = stripes; offset < blockSize; offset++)
+		{
+			tail = mixHash(tail, block[offset]);
+		}
+
+		totalSize += blockSize;
+	}
+
+	bool isRead = ferror(file) == 0;
+
+	fclose(file);
+	free(block);
+
+	unsigned long long hash = totalSize;
+
+	for (int lane = 0; lane < 4; lane++)
+	{
+		hash = mixHash(hash, lanes[lane]);
+	}
+
+	*fileHash = mixHash(hash, tail);
+
+	return isRead;
+}
+
+/// <summary>
+/// Mix one value into a hash, every bit of the value changes about half of the bits of the hash
+/// </summary>
+/// <param name="hash">hash so far</param>
+/// <param name="value">to mix in</param>
+/// <returns>The new hash</returns>
+unsigned long long mixHash(unsigned long long hash, unsigned long long value)
+{
+	hash = (hash ^ value) * 0x9E3779B185EBCA87ULL;
+	hash ^= hash >> 29;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+/// <summary>
+/// Name of the cache entry of one maze content, start position and solver policy
+/// </summary>
+/// <param name="entryName">buffer with FILENAME_MAX characters for the name</param>
+/// <param name="cacheDirectory">directory of the cache</param>
+/// <param name="fileHash">hash of the maze file</param>
+/// <param name="startPosition">X and Y of start position</param>
+/// <param name="policyName">name of the solver policy</param>
+void getCacheEntryName(char* entryName, char* cacheDirectory, unsigned long long fileHash, COORD startPosition, const char* policyName)
+{
+	unsigned long long key = mixHash(fileHash, ((unsigned long long)(unsigned short)startPosition.X << 16) | (unsigned short)startPosition.Y);
+
+	for (const char* letter = policyName; *letter != '\0'; letter++)
+	{
+		key = mixHash(key, (unsigned char)*letter);
+	}
+
+	snprintf(entryName, FILENAME_MAX, "%s\\%016llx.mzc", cacheDirectory, key);
+}
+
+/// <summary>
+/// Read the result of a cache entry. The key is stored in the entry as well, so a collision of the names is no hit.
+/// On a hit the entry is touched, the last write time is the order of the eviction.
+/// </summary>
+/// <param name="entryName">file of the cache entry</param>
+/// <param name="fileHash">hash of the maze file</param>
+/// <param name="startPosition">X and Y of start position</param>
+/// <param name="policyName">name of the solver policy</param>
+/// <param name="result">status and count of steps of the cached solve</param>
+/// <param name="path">packed way of the cached solve, the moves are reserved here</param>
+/// <returns>True on a hit</returns>
+bool readCacheEntry(char* entryName, unsigned long long fileHash, COORD startPosition, const char* policyName, solveResult* result, packedPath* path)
+{
+	FILE* file;
+
+	if (fopen_s(&file, entryName, "rb") != 0)
+		return FALSE;
+
+	cacheHeader header;
+
+	bool isHit = fread(&header, sizeof(cacheHeader), 1, file) == 1
+		&& memcmp(header.magic, CACHE_MAGIC, PACKED_MAGIC_SIZE) == 0
+		&& header.fileHash == fileHash
+		&& header.start[0] == (unsigned int)startPosition.X && header.start[1] == (unsigned int)startPosition.Y
+		&& strncmp(header.policy, policyName, CACHE_POLICY_NAME) == 0
+		&& header.status <= SolveNoWayBack;
+
+	if (isHit)
+	{
+		// Capacity in whole bytes, so the way can grow with appendPathMove as usual
+		path->start = startPosition;
+		path->length = (long long)header.length;
+		path->moveBits = PATH_MOVE_BITS;
+		path->capacity = (path->length + 3) & ~3LL;
+		path->moves = path->capacity > 0 ? (unsigned char*)malloc((size_t)getPathBytes(path, path->capacity)) : NULL;
+
+		if (path->capacity > 0 && path->moves == NULL)
+		{
+			printf("Error - Failed to reserve memory\n");
+			exit(1);
+		}
+
+		isHit = path->capacity == 0 || fread(path->moves, 1, (size_t)getPathBytes(path, path->capacity), file) == (size_t)getPathBytes(path, path->capacity);
+	}
+
+	fclose(file);
+
+	if (isHit != TRUE)
+	{
+		free(path->moves);
+		*path = (packedPath){ PATH_MOVE_BITS };
+		return FALSE;
+	}
+
+	result->status = (solveStatus)header.status;
+	result->steps = header.steps;
+	result->stepsBack = header.stepsBack;
+	result->cost = header.cost;
+	result->destination.X = (SHORT)header.destination[0];
+	result->destination.Y = (SHORT)header.destination[1];
+
+	// Mark the entry as recently used
+	HANDLE entry = CreateFileA(entryName, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (entry != INVALID_HANDLE_VALUE)
+	{
+		FILETIME now;
+		GetSystemTimeAsFileTime(&now);
+		SetFileTime(entry, NULL, &now, &now);
+		CloseHandle(entry);
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Store the result of a solve in the cache. The entry is written to a temporary file first and renamed afterwards,
+/// so a parallel solve never reads half an entry.
+/// </summary>
+/// <param name="entryName">file of the cache entry</param>
+/// <param name="cacheDirectory">directory of the cache, created when it is missing</param>
+/// <param name="fileHash">hash of the maze file</param>
+/// <param name="startPosition">X and Y of start position</param>
+/// <param name="policyName">name of the solver policy</param>
+/// <param name="result">status and count of steps</param>
+/// <param name="path">packed way from source to destination</param>
+/// <returns>True when the entry was stored</returns>
+bool writeCacheEntry(char* entryName, char* cacheDirectory, unsigned long long fileHash, COORD startPosition, const char* policyName, solveResult result, packedPath* path)
+{
+	char temporaryName[FILENAME_MAX];
+	FILE* file;
+
+	CreateDirectoryA(cacheDirectory, NULL);
+	snprintf(temporaryName, FILENAME_MAX, "%s.tmp", entryName);
+
+	if (fopen_s(&file, temporaryName, "wb") != 0)
+	{
+		printf("Error - can not write the cache entry %s\n", temporaryName);
+		return FALSE;
+	}
+
+	cacheHeader header = { 0 };
+
+	memcpy(header.magic, CACHE_MAGIC, PACKED_MAGIC_SIZE);
+	header.start[0] = (unsigned int)startPosition.X;
+	header.start[1] = (unsigned int)startPosition.Y;
+	header.status = (unsigned int)result.status;
+	header.fileHash = fileHash;
+	header.steps = result.steps;
+	header.stepsBack = result.stepsBack;
+	header.cost = result.cost;
+	header.destination[0] = (unsigned int)result.destination.X;
+	header.destination[1] = (unsigned int)result.destination.Y;
+	strncpy_s(header.policy, CACHE_POLICY_NAME, policyName, _TRUNCATE);
+
+	// Only a found way is kept, the other verdicts have no way
+	header.length = result.status == SolveFound ? (unsigned long long)path->length : 0;
+
+	fwrite(&header, sizeof(cacheHeader), 1, file);
+	fwrite(path->moves, 1, (size_t)getPathBytes(path, (long long)header.length), file);
+
+	bool isWritten = ferror(file) == 0;
+	fclose(file);
+
+	if (isWritten != TRUE || MoveFileExA(temporaryName, entryName, MOVEFILE_REPLACE_EXISTING) == FALSE)
+	{
+		printf("Error - can not store the cache entry %s\n", entryName);
+		DeleteFileA(temporaryName);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Remove the least recently used entries until the cache fits into the size limit
+/// </summary>
+/// <param name="cacheDirectory">directory of the cache</param>
+/// <param name="sizeLimit">maximum size of all entries in bytes</param>
+void evictCacheEntries(char* cacheDirectory, long long sizeLimit)
+{
+	char pattern[FILENAME_MAX];
+	WIN32_FIND_DATAA findData;
+
+	snprintf(pattern, FILENAME_MAX, "%s\\*.mzc", cacheDirectory);
+
+	HANDLE find = FindFirstFileA(pattern, &findData);
+
+	if (find == INVALID_HANDLE_VALUE)
+		return;
+
+	cacheFile* entries = NULL;
+	int entryCount = 0;
+	int entryCapacity = 0;
+	long long totalSize = 0;
+
+	do
+	{
+		if (entryCount == entryCapacity)
+		{
+			entryCapacity = entryCapacity == 0 ? BATCH_CAPACITY : entryCapacity * 2;
+			entries = (cacheFile*)realloc(entries, entryCapacity * sizeof(cacheFile));
+
+			if (entries == NULL)
+			{
+				printf("Error - Failed to reserve memory\n");
+				exit(1);
+			}
+		}
+
+		ULARGE_INTEGER lastUse;
+		lastUse.LowPart = findData.ftLastWriteTime.dwLowDateTime;
+		lastUse.HighPart = findData.ftLastWriteTime.dwHighDateTime;
+
+		snprintf(entries[entryCount].name, FILENAME_MAX, "%s\\%s", cacheDirectory, findData.cFileName);
+		entries[entryCount].lastUse = lastUse.QuadPart;
+		entries[entryCount].size = ((long long)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
+
+		totalSize += entries[entryCount].size;
+		entryCount++;
+	} while (FindNextFileA(find, &findData));
+
+	FindClose(find);
+
+	if (totalSize > sizeLimit)
+	{
+		qsort(entries, entryCount, sizeof(cacheFile), compareCacheFiles);
+
+		for (int index = 0; index < entryCount && totalSize > sizeLimit; index++)
+		{
+			if (DeleteFileA(entries[index].name))
+				totalSize -= entries[index].size;
+		}
+	}
+
+	free(entries);
+}
+
+/// <summary>
+/// Order of the eviction, the least recently used entry first
+/// </summary>
+/// <param name="first">cacheFile</param>
+/// <param name="second">cacheFile</param>
+/// <returns>Negative when first was used before second</returns>
+int compareCacheFiles(const void* first, const void* second)
+{
+	unsigned long long firstUse = ((const cacheFile*)first)->lastUse;
+	unsigned long long secondUse = ((const cacheFile*)second)->lastUse;
+
+	return (firstUse > secondUse) - (firstUse < secondUse);
+}
+
+/// <summary>
+/// Command line to solve many mazes with overlapping load, solve and output:
+/// pipeline <list> [-policy name] [-export] [-lazy]
+/// The list contains one maze per line, optional with the start position: maze [X Y]
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when every maze was solved</returns>
+int runPipeline(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s pipeline <list> [-policy name] [-export] [-lazy]\n", argv[0]);
+		return 1;
+	}
+
+	pipeline stages = { 0 };
+	char* policyName = SOLVE_DEFAULT_POLICY;
+
+	for (int index = 3; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-policy") == 0 && index + 1 < argc)
+			policyName = argv[++index];
+		else if (strcmp(argv[index], "-export") == 0)
+			stages.isExported = TRUE;
+		else if (strcmp(argv[index], "-lazy") == 0)
+			stages.isOnDemand = TRUE;
+		else
+		{
+			printf("Error - unknown pipeline option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	stages.policy = findSolverPolicy(policyName);
+
+	if (stages.policy < 0)
+	{
+		printf("Error - there is no solver policy %s\n", policyName);
+		return 1;
+	}
+
+	if (fopen_s(&stages.list, argv[2], "r") != 0)
+	{
+		printf("Error! - the list of mazes can not be open\n");
+		return 1;
+	}
+
+	// Every slot starts free, the stages hand them on through the semaphores
+	stages.freeSlots = CreateSemaphoreA(NULL, PIPELINE_DEPTH, PIPELINE_DEPTH, NULL);
+	stages.loadedSlots = CreateSemaphoreA(NULL, 0, PIPELINE_DEPTH, NULL);
+	stages.solvedSlots = CreateSemaphoreA(NULL, 0, PIPELINE_DEPTH, NULL);
+
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER startTicks;
+	LARGE_INTEGER endTicks;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&startTicks);
+
+	HANDLE reader = CreateThread(NULL, 0, pipelineReader, &stages, 0, NULL);
+	HANDLE writer = CreateThread(NULL, 0, pipelineWriter, &stages, 0, NULL);
+
+	if (stages.freeSlots == NULL || stages.loadedSlots == NULL || stages.solvedSlots == NULL || reader == NULL || writer == NULL)
+	{
+		printf("Error - can not start the pipeline\n");
+		exit(1);
+	}
+
+	// The solve stage runs here and only works on mazes which are already in memory
+	for (int index = 0;; index++)
+	{
+		pipelineSlot* slot = &stages.slots[index % PIPELINE_DEPTH];
+
+		WaitForSingleObject(stages.loadedSlots, INFINITE);
+
+		bool isLast = slot->isLast;
+
+		if (slot->error == NULL)
+		{
+			LARGE_INTEGER solveStart;
+			LARGE_INTEGER solveEnd;
+			policySolver solve = stages.isOnDemand ? solverPolicies[stages.policy].solveOnDemand : solverPolicies[stages.policy].solve;
+
+			QueryPerformanceCounter(&solveStart);
+			slot->result = solve(slot->mazeContent, slot->field, slot->dimension, slot->startPosition, &slot->path, NULL);
+			QueryPerformanceCounter(&solveEnd);
+
+			stages.solveTicks += solveEnd.QuadPart - solveStart.QuadPart;
+		}
+
+		ReleaseSemaphore(stages.solvedSlots, 1, NULL);
+
+		if (isLast)
+			break;
+	}
+
+	WaitForSingleObject(reader, INFINITE);
+	WaitForSingleObject(writer, INFINITE);
+	QueryPerformanceCounter(&endTicks);
+
+	printf("%d mazes, %d failed - load %.3fms, solve %.3fms, write %.3fms, total %.3fms\n", stages.mazeCount, stages.failureCount,
+		(double)stages.loadTicks * 1000.0 / (double)frequency.QuadPart,
+		(double)stages.solveTicks * 1000.0 / (double)frequency.QuadPart,
+		(double)stages.writeTicks * 1000.0 / (double)frequency.QuadPart,
+		(double)(endTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+	for (int index = 0; index < PIPELINE_DEPTH; index++)
+	{
+		free(stages.slots[index].path.moves);
+	}
+
+	CloseHandle(reader);
+	CloseHandle(writer);
+	CloseHandle(stages.freeSlots);
+	CloseHandle(stages.loadedSlots);
+	CloseHandle(stages.solvedSlots);
+	fclose(stages.list);
+
+	INSTR_EXPORT();
+
+	return stages.failureCount == 0 ? 0 : 1;
+}
+
+/// <summary>
+/// Load stage of the pipeline: reads and prepares the next maze of the list into a free slot.
+/// A slot with isLast closes the pipeline.
+/// </summary>
+/// <param name="parameter">the pipeline</param>
+/// <returns>Exit code of the thread</returns>
+DWORD WINAPI pipelineReader(LPVOID parameter)
+{
+	pipeline* stages = (pipeline*)parameter;
+	char line[FILENAME_MAX + BUFFER_SIZE];
+	bool isLast = FALSE;
+
+	for (int index = 0; isLast != TRUE; index++)
+	{
+		pipelineSlot* slot = &stages->slots[index % PIPELINE_DEPTH];
+
+		WaitForSingleObject(stages->freeSlots, INFINITE);
+
+		LARGE_INTEGER loadStart;
+		LARGE_INTEGER loadEnd;
+
+		QueryPerformanceCounter(&loadStart);
+
+		// Skip empty lines, the end of the list is passed on as empty last slot
+		char* mazeName = NULL;
+		char* context = NULL;
+
+		while (mazeName == NULL && fgets(line, sizeof(line), stages->list) != NULL)
+		{
+			mazeName = strtok_s(line, " \t\r\n", &context);
+		}
+
+		// The way keeps the buffer of the last maze in this slot, it only grows with a longer way
+		packedPath path = slot->path;
+
+		*slot = (pipelineSlot){ 0 };
+		slot->path = path;
+		slot->path.moveBits = PATH_MOVE_BITS;
+		slot->path.length = 0;
+		slot->startPosition.X = 1;
+		slot->startPosition.Y = 1;
+
+		if (mazeName == NULL)
+		{
+			slot->isLast = isLast = TRUE;
+			slot->error = "end of list";
+		}
+		else
+		{
+			strcpy_s(slot->mazeName, FILENAME_MAX, mazeName);
+
+			char* startX = strtok_s(NULL, " \t\r\n", &context);
+			char* startY = strtok_s(NULL, " \t\r\n", &context);
+
+			if (startX != NULL && startY != NULL)
+			{
+				slot->startPosition.X = (SHORT)atoi(startX);
+				slot->startPosition.Y = (SHORT)atoi(startY);
+			}
+
+			// Only this thread times the load and the classification, the solve stage times its own phases
+			INSTR_PHASE_BEGIN(PhaseLoad);
+			slot->field = scanFieldFromPath(slot->mazeName, &slot->dimension);
+			INSTR_PHASE_END(PhaseLoad);
+
+			if (slot->field == NULL)
+			{
+				slot->error = "can not read the maze";
+			}
+			else if (validateStartPosition(slot->field, slot->dimension, slot->startPosition) != TRUE)
+			{
+				slot->error = "invalid start position";
+			}
+			else
+			{
+				INSTR_PHASE_BEGIN(PhaseClassify);
+				slot->mazeContent = stages->isOnDemand ? getMazeContentOnDemand(slot->dimension) : getMazeContent(slot->dimension, slot->field);
+				INSTR_PHASE_END(PhaseClassify);
+			}
+		}
+
+		QueryPerformanceCounter(&loadEnd);
+		stages->loadTicks += loadEnd.QuadPart - loadStart.QuadPart;
+
+		ReleaseSemaphore(stages->loadedSlots, 1, NULL);
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// Output stage of the pipeline: prints the result of every solved slot, exports the ways and frees the slot again
+/// </summary>
+/// <param name="parameter">the pipeline</param>
+/// <returns>Exit code of the thread</returns>
+DWORD WINAPI pipelineWriter(LPVOID parameter)
+{
+	pipeline* stages = (pipeline*)parameter;
+	bool isLast = FALSE;
+
+	for (int index = 0; isLast != TRUE; index++)
+	{
+		pipelineSlot* slot = &stages->slots[index % PIPELINE_DEPTH];
+
+		WaitForSingleObject(stages->solvedSlots, INFINITE);
+
+		LARGE_INTEGER writeStart;
+		LARGE_INTEGER writeEnd;
+
+		QueryPerformanceCounter(&writeStart);
+
+		isLast = slot->isLast;
+
+		if (isLast != TRUE)
+		{
+			bool isExported = TRUE;
+
+			if (slot->error != NULL)
+			{
+				printf("%s: Error - %s\n", slot->mazeName, slot->error);
+			}
+			else
+			{
+				// The files of the way are written next to the maze
+				if (stages->isExported && slot->result.status == SolveFound)
+				{
+					isExported = exportPath(slot->mazeName, &slot->path, squareMoveNames)
+						&& exportSolvedMaze(slot->mazeName, slot->mazeContent, slot->field, slot->dimension, &slot->path);
+				}
+
+				printf("%s: %s after %lld steps, shortest way back in %lld steps with cost %lld\n", slot->mazeName,
+					solveStatusNames[slot->result.status], slot->result.steps, slot->result.stepsBack, slot->result.cost);
+			}
+
+			stages->mazeCount++;
+
+			if (slot->error != NULL || slot->result.status != SolveFound || isExported != TRUE)
+				stages->failureCount++;
+		}
+
+		for (int indexY = 0; slot->field != NULL && indexY < slot->dimension.Y; indexY++)
+		{
+			free(slot->field[indexY]);
+
+			// The on-demand content is one block, which starts at the first row
+			if (slot->mazeContent != NULL && (stages->isOnDemand != TRUE || indexY == 0))
+				free(slot->mazeContent[indexY]);
+		}
+
+		free(slot->field);
+		free(slot->mazeContent);
+
+		QueryPerformanceCounter(&writeEnd);
+		stages->writeTicks += writeEnd.QuadPart - writeStart.QuadPart;
+
+		ReleaseSemaphore(stages->freeSlots, 1, NULL);
+	}
+
+	return 0;
+}
+
+// Instantiations of the grid topologies, square4 are the steps of the console solver
+#define TOPOLOGY_NAME square4
+#define TOPOLOGY_DIRECTIONS 4
+#define TOPOLOGY_EVEN_OFFSETS { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 } }
+#define TOPOLOGY_ODD_OFFSETS TOPOLOGY_EVEN_OFFSETS
+#define TOPOLOGY_OPPOSITE { 2, 3, 0, 1 }
+#define TOPOLOGY_HEX FALSE
+#define TOPOLOGY_CORNERS CornerCutNever
+#include "TopologySolver.h"
+
+#define TOPOLOGY_NAME square8
+#define TOPOLOGY_DIRECTIONS 8
+#define TOPOLOGY_EVEN_OFFSETS { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 }, { 1, 1 }, { 1, -1 }, { -1, -1 }, { -1, 1 } }
+#define TOPOLOGY_ODD_OFFSETS TOPOLOGY_EVEN_OFFSETS
+#define TOPOLOGY_OPPOSITE { 2, 3, 0, 1, 6, 7, 4, 5 }
+#define TOPOLOGY_HEX FALSE
+#define TOPOLOGY_CORNERS CornerCutNever
+#include "TopologySolver.h"
+
+#define TOPOLOGY_NAME square8_cut
+#define TOPOLOGY_DIRECTIONS 8
+#define TOPOLOGY_EVEN_OFFSETS { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 }, { 1, 1 }, { 1, -1 }, { -1, -1 }, { -1, 1 } }
+#define TOPOLOGY_ODD_OFFSETS TOPOLOGY_EVEN_OFFSETS
+#define TOPOLOGY_OPPOSITE { 2, 3, 0, 1, 6, 7, 4, 5 }
+#define TOPOLOGY_HEX FALSE
+#define TOPOLOGY_CORNERS CornerCutOneOpen
+#include "TopologySolver.h"
+
+#define TOPOLOGY_NAME square8_free
+#define TOPOLOGY_DIRECTIONS 8
+#define TOPOLOGY_EVEN_OFFSETS { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 }, { 1, 1 }, { 1, -1 }, { -1, -1 }, { -1, 1 } }
+#define TOPOLOGY_ODD_OFFSETS TOPOLOGY_EVEN_OFFSETS
+#define TOPOLOGY_OPPOSITE { 2, 3, 0, 1, 6, 7, 4, 5 }
+#define TOPOLOGY_HEX FALSE
+#define TOPOLOGY_CORNERS CornerCutAlways
+#include "TopologySolver.h"
+
+#define TOPOLOGY_NAME hex
+#define TOPOLOGY_DIRECTIONS 6
+#define TOPOLOGY_EVEN_OFFSETS { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 } }
+#define TOPOLOGY_ODD_OFFSETS { { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, 0 }, { 0, 1 } }
+#define TOPOLOGY_OPPOSITE { 3, 4, 5, 0, 1, 2 }
+#define TOPOLOGY_HEX TRUE
+#define TOPOLOGY_CORNERS CornerCutAlways
+#include "TopologySolver.h"
+
+// Registry of all grid topologies, the square grids are ordered from the fewest to the most possible steps
+static const topologyMode topologyModes[] =
+{
+	{ "square4", squareMoveNames, step_square4, { tremaux_square4, bfs_square4, astar_square4 } },
+	{ "square8", squareMoveNames, step_square8, { tremaux_square8, bfs_square8, astar_square8 } },
+	{ "square8-cut", squareMoveNames, step_square8_cut, { tremaux_square8_cut, bfs_square8_cut, astar_square8_cut } },
+	{ "square8-free", squareMoveNames, step_square8_free, { tremaux_square8_free, bfs_square8_free, astar_square8_free } },
+	{ "hex", hexMoveNames, step_hex, { tremaux_hex, bfs_hex, astar_hex } }
+};
+
+#define TOPOLOGY_MODE_COUNT ((int)(sizeof(topologyModes) / sizeof(topologyModes[0])))
+
+/// <summary>
+/// Command line to solve a maze in the grid topologies:
+/// topology <maze> [X Y] [-grid name] [-solver name] [-route] [-export prefix]
+/// Without grid or solver every topology and every solver is run. Hex mazes shift every odd row by half an element to the right.
+/// With export every found way is written to prefix-grid-solver.rle and prefix-grid-solver.path.
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when every selected solver found a way</returns>
+int runTopology(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s topology <maze> [X Y] [-grid square4|square8|square8-cut|square8-free|hex] [-solver tremaux|bfs|astar] [-route] [-export prefix]\n", argv[0]);
+		return 1;
+	}
+
+	COORD startPosition = { 1, 1 };
+	int selectedMode = -1;
+	int selectedSolver = -1;
+	bool isRouted = FALSE;
+	char* exportPrefix = NULL;
+
+	for (int index = 3; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-grid") == 0 && index + 1 < argc)
+		{
+			selectedMode = findTopologyMode(argv[++index]);
+
+			if (selectedMode < 0)
+			{
+				printf("Error - there is no topology %s\n", argv[index]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[index], "-solver") == 0 && index + 1 < argc)
+		{
+			index++;
+
+			for (int solver = 0; solver < TOPOLOGY_SOLVER_COUNT; solver++)
+			{
+				if (strcmp(topologySolverNames[solver], argv[index]) == 0)
+					selectedSolver = solver;
+			}
+
+			if (selectedSolver < 0)
+			{
+				printf("Error - there is no topology solver %s\n", argv[index]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[index], "-route") == 0)
+			isRouted = TRUE;
+		else if (strcmp(argv[index], "-export") == 0 && index + 1 < argc)
+			exportPrefix = argv[++index];
+		else if (index + 1 < argc && argv[index][0] != '-')
+		{
+			startPosition.X = (SHORT)atoi(argv[index]);
+			startPosition.Y = (SHORT)atoi(argv[++index]);
+		}
+		else
+		{
+			printf("Error - unknown topology option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	COORD dimension = { 0 };
+	char** field = scanFieldFromPath(argv[2], &dimension);
+
+	if (field == NULL || validateStartPosition(field, dimension, startPosition) != TRUE)
+		return 1;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	packedPath path = { PATH_WIDE_MOVE_BITS };
+	int exitCode = 0;
+
+	printf("%-14s %-8s %-12s %12s %12s %12s %12s\n", "topology", "solver", "status", "steps", "steps back", "cost", "ms");
+
+	for (int mode = 0; mode < TOPOLOGY_MODE_COUNT; mode++)
+	{
+		for (int solver = 0; solver < TOPOLOGY_SOLVER_COUNT; solver++)
+		{
+			if ((selectedMode >= 0 && mode != selectedMode) || (selectedSolver >= 0 && solver != selectedSolver))
+				continue;
+
+			LARGE_INTEGER startTicks;
+			LARGE_INTEGER endTicks;
+
+			QueryPerformanceCounter(&startTicks);
+			solveResult result = topologyModes[mode].solvers[solver](field, dimension, startPosition, &path);
+			QueryPerformanceCounter(&endTicks);
+
+			printf("%-14s %-8s %-12s %12lld %12lld %12lld %12.3f\n", topologyModes[mode].name, topologySolverNames[solver],
+				solveStatusNames[result.status], result.steps, result.stepsBack, result.cost,
+				(double)(endTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+			if (isRouted && result.status == SolveFound && path.length <= SOLVE_PRINT_ROUTE_MAX)
+			{
+				char* route = encodePathRunLength(&path, topologyModes[mode].moveNames);
+				printf("Route: %s\n", route);
+				free(route);
+			}
+
+			if (exportPrefix != NULL && result.status == SolveFound)
+			{
+				char exportName[FILENAME_MAX];
+				snprintf(exportName, FILENAME_MAX, "%s-%s-%s", exportPrefix, topologyModes[mode].name, topologySolverNames[solver]);
+
+				if (exportPath(exportName, &path, topologyModes[mode].moveNames) != TRUE)
+					exitCode = 1;
+			}
+
+			if (result.status != SolveFound)
+				exitCode = 1;
+		}
+	}
+
+	for (int index = 0; index < dimension.Y; index++)
+	{
+		free(field[index]);
+	}
+
+	free(field);
+	free(path.moves);
+
+	return exitCode;
+}
+
+/// <summary>
+/// Look up a grid topology by its name in the registry
+/// </summary>
+/// <param name="name">of the topology, e.g. square8-cut</param>
+/// <returns>Index in topologyModes - returns -1 if there is no topology with this name</returns>
+int findTopologyMode(char* name)
+{
+	for (int mode = 0; mode < TOPOLOGY_MODE_COUNT; mode++)
+	{
+		if (strcmp(topologyModes[mode].name, name) == 0)
+			return mode;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Check the solvers of all grid topologies on one maze. Every way has to be valid, A* must not be more expensive than
+/// the way of the breadth-first search, which must not be longer than the other ways. The 4-connected A* has to match
+/// the reference and every square grid with more possible steps must be at least as cheap as the one before.
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="referenceCost">cost of the reference with four neighbours, -1 without way</param>
+/// <param name="seed">of the maze for the failure messages</param>
+/// <returns>Count of failed checks</returns>
+int verifyTopologies(char** field, COORD dimension, COORD startPosition, long long referenceCost, unsigned long long seed)
+{
+	int failureCount = 0;
+	long long previousCost = LLONG_MAX;
+
+	for (int mode = 0; mode < TOPOLOGY_MODE_COUNT; mode++)
+	{
+		solveResult results[TOPOLOGY_SOLVER_COUNT];
+		packedPath path = { PATH_WIDE_MOVE_BITS };
+
+		for (int solver = 0; solver < TOPOLOGY_SOLVER_COUNT; solver++)
+		{
+			char reason[VERIFY_REASON_SIZE] = "";
+
+			results[solver] = topologyModes[mode].solvers[solver](field, dimension, startPosition, &path);
+
+			if (checkSolvedPath(field, dimension, startPosition, results[solver], &path, topologyModes[mode].step, topologyModes[mode].moveNames, reason) != TRUE)
+			{
+				printf("FAIL seed %llu %s %s: %s\n", seed, topologyModes[mode].name, topologySolverNames[solver], reason);
+				failureCount++;
+			}
+		}
+
+		if (results[0].status == SolveFound && (results[1].status != SolveFound || results[1].stepsBack > results[0].stepsBack))
+		{
+			printf("FAIL seed %llu %s bfs: %s in %lld steps, tremaux found a way in %lld steps\n", seed, topologyModes[mode].name,
+				solveStatusNames[results[1].status], results[1].stepsBack, results[0].stepsBack);
+			failureCount++;
+		}
+
+		if (results[1].status != results[2].status
+			|| (results[2].status == SolveFound && (results[2].cost > results[1].cost || results[2].stepsBack < results[1].stepsBack)))
+		{
+			printf("FAIL seed %llu %s astar: %s with cost %lld in %lld steps, bfs %s with cost %lld in %lld steps\n", seed,
+				topologyModes[mode].name, solveStatusNames[results[2].status], results[2].cost, results[2].stepsBack,
+				solveStatusNames[results[1].status], results[1].cost, results[1].stepsBack);
+			failureCount++;
+		}
+
+		free(path.moves);
+
+		long long cost = results[2].status == SolveFound ? results[2].cost : -1;
+
+		if (mode == 0 && cost != referenceCost)
+		{
+			printf("FAIL seed %llu %s astar: cost %lld, the reference costs %lld\n", seed, topologyModes[mode].name, cost, referenceCost);
+			failureCount++;
+		}
+
+		if (mode > 0 && topologyModes[mode].moveNames == squareMoveNames && (cost < 0 ? LLONG_MAX : cost) > previousCost)
+		{
+			printf("FAIL seed %llu %s astar: cost %lld is above the cost %lld with fewer steps\n", seed, topologyModes[mode].name, cost, previousCost);
+			failureCount++;
+		}
+
+		previousCost = cost < 0 ? LLONG_MAX : cost;
+	}
+
+	return failureCount;
+}
+
+// Registry of the solvers of a building
+static const buildingSolver buildingSolvers[BUILDING_SOLVER_COUNT] = { tremauxBuilding, dijkstraBuilding };
+static const char* buildingSolverNames[BUILDING_SOLVER_COUNT] = { "tremaux", "dijkstra" };
+
+/// <summary>
+/// Command line to solve a maze with several levels:
+/// building <maze> [X Y Z] [-solver tremaux|dijkstra] [-route]
+/// Without solver both are run, the start position is 1:1 on the lowest level.
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when every selected solver found a way</returns>
+int runBuilding(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s building <maze> [X Y Z] [-solver tremaux|dijkstra] [-route]\n", argv[0]);
+		return 1;
+	}
+
+	buildingCoord startPosition = { 1, 1, 0 };
+	int selectedSolver = -1;
+	bool isRouted = FALSE;
+
+	for (int index = 3; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-solver") == 0 && index + 1 < argc)
+		{
+			index++;
+
+			for (int solver = 0; solver < BUILDING_SOLVER_COUNT; solver++)
+			{
+				if (strcmp(buildingSolverNames[solver], argv[index]) == 0)
+					selectedSolver = solver;
+			}
+
+			if (selectedSolver < 0)
+			{
+				printf("Error - there is no building solver %s\n", argv[index]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[index], "-route") == 0)
+			isRouted = TRUE;
+		else if (index + 2 < argc && argv[index][0] != '-')
+		{
+			startPosition.X = atoi(argv[index]);
+			startPosition.Y = atoi(argv[++index]);
+			startPosition.Z = atoi(argv[++index]);
+		}
+		else
+		{
+			printf("Error - unknown building option %s\n", argv[index]);
+			return 1;
+		}
+	}
+
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER startTicks;
+	LARGE_INTEGER endTicks;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&startTicks);
+
+	building* maze = scanBuildingFromPath(argv[2]);
+
+	QueryPerformanceCounter(&endTicks);
+
+	if (maze == NULL)
+		return 1;
+
+	printf("Building %dx%dx%d loaded in %.3fms\n", maze->width, maze->height, maze->levels,
+		(double)(endTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+	if (startPosition.X < 0 || startPosition.Y < 0 || startPosition.Z < 0 || startPosition.X >= maze->width
+		|| startPosition.Y >= maze->height || startPosition.Z >= maze->levels
+		|| BUILDING_CODE(maze, getBuildingCell(maze, startPosition)) == BuildingWall)
+	{
+		printf("Error - start position X:%d Y:%d Z:%d has to be a corridor inside the building!\n", startPosition.X, startPosition.Y, startPosition.Z);
+		freeBuilding(maze);
+		return 1;
+	}
+
+	packedPath path = { PATH_WIDE_MOVE_BITS };
+	int exitCode = 0;
+
+	printf("%-10s %-12s %12s %12s %12s %16s %12s\n", "solver", "status", "steps", "steps back", "cost", "destination", "ms");
+
+	for (int solver = 0; solver < BUILDING_SOLVER_COUNT; solver++)
+	{
+		if (selectedSolver >= 0 && solver != selectedSolver)
+			continue;
+
+		buildingCoord destination = { -1, -1, -1 };
+		char destinationText[BUFFER_SIZE * 2] = "-";
+
+		QueryPerformanceCounter(&startTicks);
+		solveResult result = buildingSolvers[solver](maze, startPosition, &path, &destination);
+		QueryPerformanceCounter(&endTicks);
+
+		if (result.status == SolveFound)
+			snprintf(destinationText, sizeof(destinationText), "%d:%d:%d", destination.X, destination.Y, destination.Z);
+
+		printf("%-10s %-12s %12lld %12lld %12lld %16s %12.3f\n", buildingSolverNames[solver], solveStatusNames[result.status],
+			result.steps, result.stepsBack, result.cost, destinationText,
+			(double)(endTicks.QuadPart - startTicks.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+
+		if (isRouted && result.status == SolveFound && path.length <= SOLVE_PRINT_ROUTE_MAX)
+		{
+			char* route = encodePathRunLength(&path, buildingMoveNames);
+			printf("Route: %s\n", route);
+			free(route);
+		}
+
+		if (result.status != SolveFound)
+			exitCode = 1;
+	}
+
+	free(path.moves);
+	freeBuilding(maze);
+
+	return exitCode;
+}
+
+/// <summary>
+/// Reserve a building where every element is a wall, the levels are surrounded by walls
+/// </summary>
+/// <param name="width">count of elements per row</param>
+/// <param name="height">count of rows per level</param>
+/// <param name="levels">count of levels</param>
+/// <returns>Dynamically building - returns NULL if the size is not valid</returns>
+building* createBuilding(int width, int height, int levels)
+{
+	if (width < 1 || height < 1 || levels < 1 || width > SHRT_MAX || height > SHRT_MAX || levels > SHRT_MAX)
+	{
+		printf("Error - the dimension [ %d | %d | %d ] of the building is not valid!\n", width, height, levels);
+		return NULL;
+	}
+
+	building* maze = (building*)malloc(sizeof(building));
+
+	if (maze == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	// At least one wall at the end of every row and an even count of elements per row, so every row starts in a new byte
+	maze->width = width;
+	maze->height = height;
+	maze->levels = levels;
+	maze->stride = ((long long)width + 2) & ~1LL;
+	maze->levelSize = maze->stride * ((long long)height + 1);
+	maze->cellCount = maze->levelSize * ((long long)levels + 2);
+	maze->cells = (unsigned char*)malloc((size_t)(maze->cellCount / 2));
+
+	if (maze->cells == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	memset(maze->cells, BuildingWall | (BuildingWall << 4), (size_t)(maze->cellCount / 2));
+
+	long long offsets[BUILDING_DIRECTIONS] = { maze->stride, 1, -maze->stride, -1, maze->levelSize, -maze->levelSize };
+	memcpy(maze->offsets, offsets, sizeof(offsets));
+
+	return maze;
+}
+
+/// <summary>
+/// Release the memory of a building
+/// </summary>
+/// <param name="maze">building from createBuilding</param>
+void freeBuilding(building* maze)
+{
+	free(maze->cells);
+	free(maze);
+}
+
+/// <summary>
+/// Index of a position in the packed elements of a building
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="coord">position with level</param>
+/// <returns>Index of the element</returns>
+long long getBuildingCell(building* maze, buildingCoord coord)
+{
+	return ((long long)coord.Z + 1) * maze->levelSize + (long long)coord.Y * maze->stride + coord.X;
+}
+
+/// <summary>
+/// Position of an element of a building, only needed for the results
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="cell">index of the element</param>
+/// <returns>Position with level</returns>
+buildingCoord getBuildingCoord(building* maze, long long cell)
+{
+	buildingCoord coord;
+	long long levelCell = cell % maze->levelSize;
+
+	coord.X = (int)(levelCell % maze->stride);
+	coord.Y = (int)(levelCell / maze->stride);
+	coord.Z = (int)(cell / maze->levelSize) - 1;
+
+	return coord;
+}
+
+/// <summary>
+/// One step in a building, the walls around every level replace the checks of the borders.
+/// Up and down are only possible from stairs up to stairs down and in elevators.
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="cell">index of the element before the step</param>
+/// <param name="direction">index in buildingMoveNames</param>
+/// <param name="nextCell">index of the element after the step</param>
+/// <returns>True when the step is possible</returns>
+bool isBuildingStep(building* maze, long long cell, int direction, long long* nextCell)
+{
+	*nextCell = cell + maze->offsets[direction];
+
+	// The other level is far away in memory, so it is only read from stairs and elevators
+	if (direction == BUILDING_ABOVE)
+		return ((BUILDING_UP_CODES >> BUILDING_CODE(maze, cell)) & 1) && ((BUILDING_DOWN_CODES >> BUILDING_CODE(maze, *nextCell)) & 1);
+
+	if (direction == BUILDING_BELOW)
+		return ((BUILDING_DOWN_CODES >> BUILDING_CODE(maze, cell)) & 1) && ((BUILDING_UP_CODES >> BUILDING_CODE(maze, *nextCell)) & 1);
+
+	return BUILDING_CODE(maze, *nextCell) != BuildingWall;
+}
+
+/// <summary>
+/// Read a building in the text form or packed with four bits per element. The text form starts with "X Y Z" and has
+/// the levels in sequence, empty lines between them are skipped. Without Z the maze has one level.
+/// </summary>
+/// <param name="pathToBuilding">for the target maze</param>
+/// <returns>Dynamically building - returns NULL if the file is not valid</returns>
+building* scanBuildingFromPath(char* pathToBuilding)
+{
+	FILE* file;
+
+	if (fopen_s(&file, pathToBuilding, "rb") != 0)
+	{
+		printf("Error! - this file can not be open\n");
+		return NULL;
+	}
+
+	char magic[PACKED_MAGIC_SIZE] = { 0 };
+
+	if (fread(magic, 1, PACKED_MAGIC_SIZE, file) == PACKED_MAGIC_SIZE && memcmp(magic, BUILDING_MAGIC, PACKED_MAGIC_SIZE) == 0)
+	{
+		building* packedMaze = scanBuildingFromPackedFile(file);
+		fclose(file);
+		return packedMaze;
+	}
+
+	rewind(file);
+
+	char header[BUFFER_SIZE * 2] = { 0 };
+	int width = 0;
+	int height = 0;
+	int levels = 1;
+
+	if (fgets(header, sizeof(header), file) == NULL || sscanf_s(header, "%d %d %d", &width, &height, &levels) < 2)
+	{
+		printf("Error - the header of the building is not valid\n");
+		fclose(file);
+		return NULL;
+	}
+
+	building* maze = createBuilding(width, height, levels);
+	unsigned char* buffer = (unsigned char*)malloc(BUILDING_READ_BLOCK);
+
+	if (maze == NULL || buffer == NULL)
+	{
+		fclose(file);
+		free(buffer);
+		return NULL;
+	}
+
+	// Code of every character, the cost digits 2 to 9 follow the terrain code
+	unsigned char codes[256];
+	memset(codes, BUILDING_INVALID, sizeof(codes));
+	codes['0'] = BuildingCorridor;
+	codes['1'] = BuildingWall;
+	codes['X'] = BuildingDestination;
+	codes['^'] = BuildingStairsUp;
+	codes['v'] = BuildingStairsDown;
+	codes['E'] = BuildingElevator;
+	codes[' '] = BUILDING_SKIP;
+	codes['\t'] = BUILDING_SKIP;
+	codes['\r'] = BUILDING_SKIP;
+	codes['\n'] = BUILDING_NEWLINE;
+
+	for (char digit = '2'; digit <= '0' + TERRAIN_COST_MAX; digit++)
+	{
+		codes[(unsigned char)digit] = (unsigned char)(BuildingTerrain + digit - '2');
+	}
+
+	buildingCoord coord = { 0, 0, 0 };
+	long long cell = getBuildingCell(maze, coord);
+	unsigned char pending = 0;
+	bool isValid = TRUE;
+	size_t count;
+
+	// Two elements are collected into one byte, every row starts in a new byte
+	while (isValid && (count = fread(buffer, 1, BUILDING_READ_BLOCK, file)) > 0)
+	{
+		for (size_t index = 0; index < count; index++)
+		{
+			unsigned char code = codes[buffer[index]];
+
+			if (code < BUILDING_SKIP)
+			{
+				if (coord.X >= maze->width || coord.Z >= maze->levels)
+				{
+					printf("Error - row %d of level %d is longer than %d elements\n", coord.Y, coord.Z, maze->width);
+					isValid = FALSE;
+					break;
+				}
+
+				if (coord.X & 1)
+					maze->cells[cell >> 1] = (unsigned char)(pending | (code << 4));
+				else
+					pending = code;
+
+				coord.X++;
+				cell++;
+			}
+			else if (code == BUILDING_NEWLINE && coord.X > 0)
+			{
+				if (finishBuildingRow(maze, &coord, pending) != TRUE)
+				{
+					isValid = FALSE;
+					break;
+				}
+
+				cell = getBuildingCell(maze, coord);
+			}
+			else if (code == BUILDING_INVALID)
+			{
+				printf("Error - unknown element '%c' in row %d of level %d\n", buffer[index], coord.Y, coord.Z);
+				isValid = FALSE;
+				break;
+			}
+		}
+	}
+
+	// The last row may end without line break
+	if (isValid && coord.X > 0)
+		isValid = finishBuildingRow(maze, &coord, pending);
+
+	if (isValid && coord.Z != maze->levels)
+	{
+		printf("Error - the building ends in row %d of level %d\n", coord.Y, coord.Z);
+		isValid = FALSE;
+	}
+
+	free(buffer);
+	fclose(file);
+
+	if (isValid != TRUE)
+	{
+		freeBuilding(maze);
+		return NULL;
+	}
+
+	return maze;
+}
+
+/// <summary>
+/// Check the width of a finished row of the text form and go on with the next row
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="coord">position behind the last element of the row, moved to the start of the next row</param>
+/// <param name="pending">element of an odd row which is not written yet</param>
+/// <returns>True when the row has the width of the header</returns>
+bool finishBuildingRow(building* maze, buildingCoord* coord, unsigned char pending)
+{
+	if (coord->X != maze->width)
+	{
+		printf("Error - row %d of level %d has %d instead of %d elements\n", coord->Y, coord->Z, coord->X, maze->width);
+		return FALSE;
+	}
+
+	// The last byte of an odd row gets the wall behind the row
+	if (coord->X & 1)
+		maze->cells[getBuildingCell(maze, *coord) >> 1] = (unsigned char)(pending | (BuildingWall << 4));
+
+	coord->X = 0;
+	coord->Y++;
+
+	if (coord->Y == maze->height)
+	{
+		coord->Y = 0;
+		coord->Z++;
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Read the packed form of a building after its magic: width, height and levels as 32 bit integers,
+/// then every row with two elements per byte. The rows are read directly into place.
+/// </summary>
+/// <param name="file">opened behind the magic</param>
+/// <returns>Dynamically building - returns NULL if the file is not valid</returns>
+building* scanBuildingFromPackedFile(FILE* file)
+{
+	unsigned int header[3] = { 0 };
+
+	if (fread(header, sizeof(unsigned int), 3, file) != 3)
+	{
+		printf("Error - the header of the packed building is not valid\n");
+		return NULL;
+	}
+
+	building* maze = createBuilding((int)header[0], (int)header[1], (int)header[2]);
+
+	if (maze == NULL)
+		return NULL;
+
+	size_t rowSize = ((size_t)maze->width + 1) / 2;
+
+	for (buildingCoord coord = { 0, 0, 0 }; coord.Z < maze->levels; coord.Z++)
+	{
+		for (coord.Y = 0; coord.Y < maze->height; coord.Y++)
+		{
+			unsigned char* row = maze->cells + (getBuildingCell(maze, coord) >> 1);
+
+			if (fread(row, 1, rowSize, file) != rowSize)
+			{
+				printf("Error - the packed building is to short\n");
+				freeBuilding(maze);
+				return NULL;
 			}
 
-			// Create the destination type
-			if (field[indexY][indexX] == 'X')
+			// Keep the wall behind an odd row
+			if (maze->width & 1)
+				row[rowSize - 1] = (unsigned char)((row[rowSize - 1] & 0x0F) | (BuildingWall << 4));
+		}
+	}
+
+	return maze;
+}
+
+/// <summary>
+/// Solve a building with Tremaux' marks on the passages between neighbours like the grid topologies,
+/// stairs and elevators are passages to the level above or below
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="startPosition">the source position with level</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+/// <param name="destination">receives the reached destination</param>
+/// <returns>Status, the counted steps and the cost of the way</returns>
+solveResult tremauxBuilding(building* maze, buildingCoord startPosition, packedPath* path, buildingCoord* destination)
+{
+	solveResult result = { 0 };
+	long long stepLimit = maze->cellCount * SOLVER_STEP_LIMIT_FACTOR;
+
+	// A position without marks was never visited, the source gets its first mark with the first step
+	unsigned short* marks = (unsigned short*)calloc((size_t)maze->cellCount, sizeof(unsigned short));
+
+	if (marks == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	long long startCell = getBuildingCell(maze, startPosition);
+	long long cell = startCell;
+	bool isKnown = FALSE;
+	int arrival = -1;
+
+	result.status = SolveFound;
+
+	while (BUILDING_CODE(maze, cell) != BuildingDestination)
+	{
+		int direction = -1;
+		long long nextCell = cell;
+
+		if (isKnown && PASSAGE_MARKS(marks[cell], buildingOpposite[arrival]) == 1)
+		{
+			// Known position over a new passage, go back
+			direction = buildingOpposite[arrival];
+			nextCell = cell + maze->offsets[direction];
+		}
+
+		for (int candidate = 0; candidate < BUILDING_DIRECTIONS && direction < 0; candidate++)
+		{
+			if (PASSAGE_MARKS(marks[cell], candidate) == 0 && isBuildingStep(maze, cell, candidate, &nextCell))
+				direction = candidate;
+		}
+
+		for (int candidate = 0; candidate < BUILDING_DIRECTIONS && direction < 0; candidate++)
+		{
+			if (PASSAGE_MARKS(marks[cell], candidate) == 1 && isBuildingStep(maze, cell, candidate, &nextCell))
+				direction = candidate;
+		}
+
+		// Every passage was passed twice
+		if (direction < 0)
+		{
+			result.status = SolveNoSolution;
+			break;
+		}
+
+		isKnown = marks[nextCell] != 0;
+		marks[cell] += (unsigned short)(1 << (direction * 2));
+		marks[nextCell] += (unsigned short)(1 << (buildingOpposite[direction] * 2));
+
+		arrival = direction;
+		cell = nextCell;
+		result.steps++;
+
+		if (result.steps > stepLimit)
+		{
+			result.status = SolveStepLimit;
+			break;
+		}
+	}
+
+	if (result.status == SolveFound)
+	{
+		*destination = getBuildingCoord(maze, cell);
+		result.destination.X = (SHORT)destination->X;
+		result.destination.Y = (SHORT)destination->Y;
+
+		if (path != NULL)
+			path->length = 0;
+
+		// Follow the passages with one mark back to the source
+		int back = -1;
+
+		while (cell != startCell)
+		{
+			int direction = -1;
+			long long nextCell = cell;
+
+			for (int candidate = 0; candidate < BUILDING_DIRECTIONS && direction < 0; candidate++)
 			{
-				element content;
-				content.type = Destination;
-				markArray[indexY][indexX] = content;
-				continue;
+				if (candidate != back && PASSAGE_MARKS(marks[cell], candidate) == 1 && isBuildingStep(maze, cell, candidate, &nextCell))
+					direction = candidate;
 			}
 
-			/*
-			* Scan from top to bottom and left to right
-					   -->
-					  |	1 1 0 1 1
-					  v 1 1 M 1 1
-						0 M 0 M 0
-			Skip the M:	> > M >
+			if (direction < 0 || result.stepsBack > stepLimit)
+			{
+				result.status = SolveNoWayBack;
+				break;
+			}
 
-			*/
+			if (path != NULL)
+				appendPathMove(path, direction);
 
-			// When array is already marked skip this one
-			if (markArray[indexY][indexX].type == Marker)
-			{
+			result.cost += buildingCosts[BUILDING_CODE(maze, cell)];
+			result.stepsBack++;
+			back = buildingOpposite[direction];
+			cell = nextCell;
+		}
+
+		// The way was recorded backwards from the destination
+		if (path != NULL && result.status == SolveFound)
+		{
+			COORD start = { (SHORT)startPosition.X, (SHORT)startPosition.Y };
+			reversePath(path, start, buildingOpposite);
+		}
+	}
+
+	free(marks);
+
+	return result;
+}
+
+/// <summary>
+/// Cheapest way through a building with the buckets of dijkstra(), a step to another level costs like a corridor
+/// </summary>
+/// <param name="maze">the building</param>
+/// <param name="startPosition">the source position with level</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+/// <param name="destination">receives the reached destination</param>
+/// <returns>Status, the settled positions as steps, the steps and the cost of the way</returns>
+solveResult dijkstraBuilding(building* maze, buildingCoord startPosition, packedPath* path, buildingCoord* destination)
+{
+	solveResult result = { 0 };
+
+	// Costs are only valid for reached positions and stay below 2^32 for every building up to SHRT_MAX per side and level
+	unsigned int* costs = (unsigned int*)malloc((size_t)maze->cellCount * sizeof(unsigned int));
+	unsigned char* arrivals = (unsigned char*)malloc((size_t)maze->cellCount);
+	costBucket buckets[DIJKSTRA_BUCKETS] = { 0 };
+
+	if (costs == NULL || arrivals == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	memset(arrivals, TOPOLOGY_UNREACHED, (size_t)maze->cellCount);
+
+	long long startCell = getBuildingCell(maze, startPosition);
+	long long destinationCell = -1;
+	long long queued = 1;
+
+	costs[startCell] = 0;
+	arrivals[startCell] = TOPOLOGY_SOURCE;
+	pushCostBucket(&buckets[0], startCell);
+
+	for (long long currentCost = 0; queued > 0 && destinationCell < 0; currentCost++)
+	{
+		costBucket* bucket = &buckets[currentCost % DIJKSTRA_BUCKETS];
+
+		for (long long entry = 0; entry < bucket->count; entry++)
+		{
+			long long cell = bucket->cells[entry];
+
+			// Positions which got cheaper afterwards are still in the older bucket
+			if (costs[cell] != currentCost)
 				continue;
+
+			result.steps++;
+
+			if (BUILDING_CODE(maze, cell) == BuildingDestination)
+			{
+				destinationCell = cell;
+				break;
 			}
 
-			// Check all directions if there is another corridor 
-			if (indexX > 0 && indexY > 0 && (field[indexY][indexX] == '0' || field[indexY][indexX] == 'X'))
+			for (int direction = 0; direction < BUILDING_DIRECTIONS; direction++)
 			{
-				// Count up all corridors possibilitys
-				int countCorners = 0;
+				long long neighbour;
 
-				// Check above for a corridor
-				if (field[indexY - 1][indexX] == '0')
-					countCorners++;
+				if (isBuildingStep(maze, cell, direction, &neighbour) != TRUE)
+					continue;
 
-				// Check right for a corridor
-				if (field[indexY][indexX + 1] == '0')
-					countCorners++;
+				unsigned int nextCost = (unsigned int)currentCost + buildingCosts[BUILDING_CODE(maze, neighbour)];
 
-				// Check below for a corridor
-				if (field[indexY + 1][indexX] == '0')
-					countCorners++;
+				if (arrivals[neighbour] == TOPOLOGY_UNREACHED || nextCost < costs[neighbour])
+				{
+					costs[neighbour] = nextCost;
+					arrivals[neighbour] = (unsigned char)direction;
+					pushCostBucket(&buckets[nextCost % DIJKSTRA_BUCKETS], neighbour);
+					queued++;
+				}
+			}
+		}
 
-				// Check left for a corridor
-				if (field[indexY][indexX - 1] == '0')
-					countCorners++;
+		queued -= bucket->count;
+		bucket->count = 0;
+	}
 
-				// If there are more than two corridors mark everyone
-				/*
-				* Example 1   Example 2
-				   | |			   | |
-				___|M|___	       |M|___
-				__M   M__		   |  M__
-				   |M|			   |M|
-				   | |			   | |
-				*/
+	if (destinationCell < 0)
+	{
+		result.status = SolveNoSolution;
+	}
+	else
+	{
+		*destination = getBuildingCoord(maze, destinationCell);
+		result.status = SolveFound;
+		result.destination.X = (SHORT)destination->X;
+		result.destination.Y = (SHORT)destination->Y;
+		result.cost = costs[destinationCell];
 
-				if (countCorners > 2)
-				{
-					if (countCorners > 3)
-					{
-						// More than 3 corridors -> everything have to be marked
-						if (field[indexY - 1][indexX] != 'X')
-							markArray[indexY - 1][indexX].type = Marker;
+		if (path != NULL)
+			path->length = 0;
 
-						if (field[indexY][indexX + 1] != 'X')
-							markArray[indexY][indexX + 1].type = Marker;
+		// Follow the arrivals back to the source
+		for (long long cell = destinationCell; arrivals[cell] != TOPOLOGY_SOURCE; cell -= maze->offsets[arrivals[cell]])
+		{
+			if (path != NULL)
+				appendPathMove(path, buildingOpposite[arrivals[cell]]);
 
-						if (field[indexY + 1][indexX] != 'X')
-							markArray[indexY + 1][indexX].type = Marker;
+			result.stepsBack++;
+		}
 
-						if (field[indexY][indexX - 1] != 'X')
-							markArray[indexY][indexX - 1].type = Marker;
+		if (path != NULL)
+		{
+			COORD start = { (SHORT)startPosition.X, (SHORT)startPosition.Y };
+			reversePath(path, start, buildingOpposite);
+		}
+	}
 
-						// Check center is not marked
-						if (markArray[indexY][indexX].type != Marker)
-							markArray[indexY][indexX].type = Corridor;
+	for (int bucket = 0; bucket < DIJKSTRA_BUCKETS; bucket++)
+	{
+		free(buckets[bucket].cells);
+	}
 
-						continue;
-					}
-					else
-					{
-						// Check which direction is a corridor and mark this one
-						if (field[indexY - 1][indexX] == '0')
-							markArray[indexY - 1][indexX].type = Marker;
+	free(costs);
+	free(arrivals);
 
-						if (field[indexY][indexX + 1] == '0' && field[indexY][indexX + 1] != 'X')
-							markArray[indexY][indexX + 1].type = Marker;
+	return result;
+}
 
-						if (field[indexY + 1][indexX] == '0' && field[indexY + 1][indexX] != 'X')
-							markArray[indexY + 1][indexX].type = Marker;
+/// <summary>
+/// Solve with one checkpoint in the middle of the search, then solve again from this checkpoint with cleared tags
+/// like after a kill and -resume. Both classifications must give the steps and the way of the solve without break.
+/// </summary>
+/// <param name="mazeContent">content of the maze with all types and without tags, it is cleared again afterwards</param>
+/// <param name="field">the scratch maze</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="policy">index of a Tremaux' policy in solverPolicies</param>
+/// <param name="reference">result of the solve without break</param>
+/// <param name="referencePath">way of the solve without break</param>
+/// <param name="reason">receives the description of the first error</param>
+/// <returns>True when every resumed solve is identical</returns>
+bool verifyResume(element** mazeContent, char** field, COORD dimension, COORD startPosition, int policy, solveResult reference, packedPath* referencePath, char* reason)
+{
+	// The second checkpoint would be behind the destination, so the file keeps the one in the middle
+	long long stepInterval = reference.steps / 2 + 1;
+	bool isValid = TRUE;
 
-						if (field[indexY][indexX - 1] == '0' && field[indexY][indexX - 1] != 'X')
-							markArray[indexY][indexX - 1].type = Marker;
+	for (int mode = 0; mode < 2 && isValid; mode++)
+	{
+		policySolver solve = mode == 0 ? solverPolicies[policy].solve : solverPolicies[policy].solveOnDemand;
+		packedPath path = { PATH_MOVE_BITS };
+		solveResult result = { 0 };
+		int writeCount = 0;
 
-						// Check center is not marked
-						if (markArray[indexY][indexX].type != Marker)
-							markArray[indexY][indexX].type = Corridor;
+		for (int run = 0; run < 2; run++)
+		{
+			element** content = mode == 0 ? mazeContent : getMazeContentOnDemand(dimension);
+			solveCheckpoint* checkpoint = createCheckpoint(VERIFY_CHECKPOINT_FILE, 0, solverPolicies[policy].name, dimension, stepInterval, 0);
 
-						continue;
-					}
-				}
-				else
-				{
-					// When there are less then three corridors it is a normal corridor
-					if (markArray[indexY][indexX].type != Marker)
-					{
-						markArray[indexY][indexX].type = Corridor;
-					}
+			if (run == 0 || readCheckpoint(checkpoint, content, dimension, startPosition))
+				result = solve(content, field, dimension, startPosition, &path, checkpoint);
+			else
+				result.status = SolveNoSolution;
+
+			if (run == 0)
+				writeCount = checkpoint->writeCount;
+
+			freeCheckpoint(checkpoint);
+
+			if (mode == 0)
+			{
+				resetMazeContent(mazeContent, dimension);
+			}
+			else
+			{
+				free(content[0]);
+				free(content);
+			}
+		}
+
+		bool isSameWay = path.length == referencePath->length;
+
+		for (long long index = 0; isSameWay && result.status == SolveFound && index < path.length; index++)
+		{
+			isSameWay = getPathMove(&path, index) == getPathMove(referencePath, index);
+		}
+
+		if (writeCount != 1 || result.status != reference.status || result.steps != reference.steps
+			|| result.stepsBack != reference.stepsBack || result.cost != reference.cost || isSameWay != TRUE)
+		{
+			snprintf(reason, VERIFY_REASON_SIZE, "%s resume at step %lld after %d checkpoints gives %s after %lld steps instead of %lld steps",
+				mode == 0 ? "full" : "on-demand", stepInterval, writeCount, solveStatusNames[result.status], result.steps, reference.steps);
+			isValid = FALSE;
+		}
+
+		free(path.moves);
+	}
+
+	remove(VERIFY_CHECKPOINT_FILE);
+
+	return isValid;
+}
+
+/// <summary>
+/// Parse a maze in the text form with every count of chunks from 1 to PARSER_THREADS_MAX and compare the fields with a
+/// parse byte by byte. The same is done for a copy with tabs, double spaces, " \t " and "\r\n" in some rows, which the
+/// fast path of parseTextRow() leaves to its scalar loop.
+/// </summary>
+/// <param name="pathToField">maze in the usual text form</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="seed">of the maze for the report</param>
+/// <returns>Count of failed checks</returns>
+int verifyTextParser(char* pathToField, COORD dimension, unsigned long long seed)
+{
+	char* reference = (char*)malloc((size_t)dimension.X * dimension.Y);
+	FILE* file = NULL;
+
+	if (reference == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	if (fopen_s(&file, pathToField, "rb") != 0 || file == NULL)
+	{
+		printf("FAIL seed %llu parser: %s can not be opened\n", seed, pathToField);
+		free(reference);
+		return VERIFY_PARSER_CHECKS;
+	}
+
+	// Skip the header, every other character except separators is the next element
+	int character = 0;
+	long long count = 0;
+
+	while ((character = fgetc(file)) != EOF && character != '\n');
+
+	while ((character = fgetc(file)) != EOF)
+	{
+		if (character != EMPTY_SPACE && character != '\t' && character != '\r' && character != '\n'
+			&& count < (long long)dimension.X * dimension.Y)
+			reference[count++] = (char)character;
+	}
+
+	fclose(file);
+
+	// The rows get in turn single spaces, tabs, double spaces with a carriage return and tabs between spaces,
+	// where every odd byte is still a space
+	if (fopen_s(&file, VERIFY_TEXT_FILE, "wb") != 0 || file == NULL)
+	{
+		printf("FAIL seed %llu parser: %s can not be written\n", seed, VERIFY_TEXT_FILE);
+		free(reference);
+		return VERIFY_PARSER_CHECKS;
+	}
+
+	static const char* separators[4] = { " ", "\t", "  ", " \t " };
+
+	fprintf(file, "%d %d\n", dimension.X, dimension.Y);
+
+	for (int y = 0; y < dimension.Y; y++)
+	{
+		const char* separator = separators[y % 4];
+
+		for (int x = 0; x < dimension.X; x++)
+		{
+			fprintf(file, "%c%s", reference[(long long)y * dimension.X + x], separator);
+		}
+
+		fputs(y % 4 == 2 ? "\r\n" : "\n", file);
+	}
+
+	fclose(file);
+
+	char* fileNames[VERIFY_PARSER_CHECKS] = { pathToField, VERIFY_TEXT_FILE };
+	int failureCount = 0;
+
+	for (int check = 0; check < VERIFY_PARSER_CHECKS; check++)
+	{
+		for (int chunkCount = 1; chunkCount <= PARSER_THREADS_MAX; chunkCount++)
+		{
+			COORD parsedDimension = { 0 };
+			char** field = scanFieldFromText(fileNames[check], &parsedDimension, chunkCount);
+			bool isSame = field != NULL && count == (long long)dimension.X * dimension.Y
+				&& parsedDimension.X == dimension.X && parsedDimension.Y == dimension.Y;
+
+			for (int y = 0; y < dimension.Y && isSame; y++)
+			{
+				isSame = memcmp(field[y], reference + (long long)y * dimension.X, dimension.X) == 0;
+			}
+
+			if (field != NULL)
+			{
+				for (int y = 0; y < parsedDimension.Y; y++)
+				{
+					free(field[y]);
 				}
+
+				free(field);
+			}
+
+			if (isSame != TRUE)
+			{
+				printf("FAIL seed %llu parser: %d chunks of %s give another field than a parse byte by byte\n", seed, chunkCount, fileNames[check]);
+				failureCount++;
+				break;
 			}
 		}
 	}
 
-	return markArray;
+	free(reference);
+
+	return failureCount;
 }
 
 /// <summary>
-/// Algorithm to solve complexe maze with calculation to get the way back to source
+/// Generate a building in the text and the packed form and check both loads, the stairs and both building solvers.
+/// Small buildings get many stairs, so the generator places several of them on the same position.
 /// </summary>
-/// <param name="hConsole">where to display the maze solving</param>
-/// <param name="elementField">content of the maze with all types</param>
-/// <param name="dimension">of the maze in coordination</param>
-/// <param name="startPosition">the source position</param>
-/// <param name="speed">Delay time in milliseconds</param>
-void tremaux(HANDLE hConsole, element** elementField, COORD dimension, COORD startPosition, int speed)
+/// <param name="seed">of the generator</param>
+/// <param name="variant">index of the maze in the verify run, selects size, levels and stairs</param>
+/// <returns>Count of failed checks</returns>
+int verifyBuilding(unsigned long long seed, int variant)
 {
-	if (elementField == NULL)
-	{
-		printObject2Console(hConsole, dimension, "Error - Something went wrong when start the algorithm!\n", D_FGREEN, BBLACK);
-		exit(1);
-	}
+	generatorSettings settings = { 0 };
+	settings.width = variant % 2 == 0 ? VERIFY_BUILDING_SIZE : 11;
+	settings.height = variant % 2 == 0 ? VERIFY_BUILDING_SIZE : 11;
+	settings.seed = seed;
+	settings.levels = 2 + variant % 4;
+	settings.stairs = variant % 2 == 0 ? 1 + variant % 3 : GENERATOR_STAIRS;
+	settings.loopPercent = (variant % 3) * 10;
+	settings.destination = DestinationCorner;
 
-	COORD latestCoord = { 0 };
-	COORD currentCoord = startPosition;
-	COORD nextCoord = startPosition;
+	if (generateMaze(VERIFY_BUILDING_FILE, settings) != TRUE)
+		return VERIFY_BUILDING_CHECKS;
 
-	char emptySpace[] = " ";
+	settings.binary = TRUE;
 
-	// Iterate the algorithm until the current coordination is the destination
-	while (elementField[nextCoord.Y][nextCoord.X].type != Destination)
-	{
-		// Set current Coordination
-		currentCoord = nextCoord;
+	if (generateMaze(VERIFY_PACKED_FILE, settings) != TRUE)
+		return VERIFY_BUILDING_CHECKS;
 
-		// get next Coordination by passing by the rules
-		nextCoord = firstRule(elementField, currentCoord, latestCoord);
+	building* maze = scanBuildingFromPath(VERIFY_BUILDING_FILE);
+	building* packed = scanBuildingFromPath(VERIFY_PACKED_FILE);
 
-		if (nextCoord.X == 0 && nextCoord.Y == 0)
-		{
-			printObject2Console(hConsole, dimension, "Error - Maze has no solution!\n", D_FGREEN, BBLACK);
-			exit(1);
-		}
+	if (maze == NULL || packed == NULL)
+	{
+		printf("FAIL seed %llu building: the generated building cannot be read\n", seed);
 
-		// set latest Coordination
-		latestCoord = currentCoord;
+		if (maze != NULL)
+			freeBuilding(maze);
 
-		printObject2Console(hConsole, nextCoord, ROBOTER, FBLACK, BWHITE);
+		if (packed != NULL)
+			freeBuilding(packed);
 
-		// Clear the latest position of the Roboter
-		if (elementField[currentCoord.Y][currentCoord.X].type != Marker)
-			printObject2Console(hConsole, latestCoord, emptySpace, FBLACK, BWHITE);
+		return VERIFY_BUILDING_CHECKS;
+	}
 
-		// When step on a marker tag this one
-		if (elementField[currentCoord.Y][currentCoord.X].type == Marker)
+	int failureCount = 0;
+	bool isSameCells = maze->width == packed->width && maze->height == packed->height && maze->levels == packed->levels;
+	bool isStairsPaired = TRUE;
+
+	for (int level = 0; level < maze->levels && isSameCells; level++)
+	{
+		for (int y = 0; y < maze->height && isSameCells; y++)
 		{
-			// If this marker has not been used yet, tag this for the first time
-			if (elementField[currentCoord.Y][currentCoord.X].markOne == FALSE)
-			{
-				elementField[currentCoord.Y][currentCoord.X].markOne = TRUE;
-				SetConsoleCursorPosition(hConsole, currentCoord);
-				printf(FBLACK BYELLOW" "DEFAULT_COLOR);
-			}
-			// If this marker is already taged once, mark this a second time
-			else if (elementField[currentCoord.Y][currentCoord.X].markTwo == FALSE)
+			for (int x = 0; x < maze->width && isSameCells; x++)
 			{
-				elementField[currentCoord.Y][currentCoord.X].markTwo = TRUE;
-				SetConsoleCursorPosition(hConsole, currentCoord);
-				printf(FBLACK BRED" "DEFAULT_COLOR);
+				buildingCoord coord = { x, y, level };
+				long long cell = getBuildingCell(maze, coord);
+				long long nextCell;
+
+				isSameCells = BUILDING_CODE(maze, cell) == BUILDING_CODE(packed, cell);
+
+				// Every way up has a way down on the level above and the other way round
+				if (((BUILDING_UP_CODES >> BUILDING_CODE(maze, cell)) & 1) && isBuildingStep(maze, cell, BUILDING_ABOVE, &nextCell) != TRUE)
+					isStairsPaired = FALSE;
+
+				if (((BUILDING_DOWN_CODES >> BUILDING_CODE(maze, cell)) & 1) && isBuildingStep(maze, cell, BUILDING_BELOW, &nextCell) != TRUE)
+					isStairsPaired = FALSE;
 			}
 		}
+	}
 
+	if (isSameCells != TRUE)
+	{
+		printf("FAIL seed %llu building %dx%dx%d: the text and the packed form differ\n", seed, maze->width, maze->height, maze->levels);
+		failureCount++;
+	}
 
-		Sleep(speed);
+	if (isStairsPaired != TRUE)
+	{
+		printf("FAIL seed %llu building %dx%dx%d: a stair leads to no stair\n", seed, maze->width, maze->height, maze->levels);
+		failureCount++;
 	}
 
-	// Display the solution
-	if (elementField[nextCoord.Y][nextCoord.X].type == Destination)
+	buildingCoord startPosition = { 1, 1, 0 };
+	solveResult results[BUILDING_SOLVER_COUNT] = { 0 };
+
+	for (int solver = 0; solver < BUILDING_SOLVER_COUNT; solver++)
 	{
-		printObject2Console(hConsole, dimension, "Found one way to the destination\n", D_FGREEN, BBLACK);
+		char reason[VERIFY_REASON_SIZE] = "";
+		packedPath path = { PATH_WIDE_MOVE_BITS };
+		buildingCoord destination = { 0 };
+
+		results[solver] = buildingSolvers[solver](maze, startPosition, &path, &destination);
+
+		// The generator connects every level, so there is always a way
+		if (results[solver].status != SolveFound)
+			snprintf(reason, VERIFY_REASON_SIZE, "%s in a connected building", solveStatusNames[results[solver].status]);
+		else
+			checkBuildingPath(maze, startPosition, results[solver], &path, reason);
+
+		if (reason[0] != '\0')
+		{
+			printf("FAIL seed %llu building %dx%dx%d %s: %s\n", seed, maze->width, maze->height, maze->levels, buildingSolverNames[solver], reason);
+			failureCount++;
+		}
+
+		free(path.moves);
 	}
 
-	Sleep(SHOW_SETTINGS_TIME);
+	// The last solver is the optimal one
+	for (int solver = 0; solver < BUILDING_SOLVER_COUNT - 1; solver++)
+	{
+		if (results[solver].status != results[BUILDING_SOLVER_COUNT - 1].status
+			|| (results[solver].status == SolveFound && results[solver].cost < results[BUILDING_SOLVER_COUNT - 1].cost))
+		{
+			printf("FAIL seed %llu building %dx%dx%d: %s gives %s with cost %lld, %s gives %s with cost %lld\n",
+				seed, maze->width, maze->height, maze->levels, buildingSolverNames[solver], solveStatusNames[results[solver].status],
+				results[solver].cost, buildingSolverNames[BUILDING_SOLVER_COUNT - 1],
+				solveStatusNames[results[BUILDING_SOLVER_COUNT - 1].status], results[BUILDING_SOLVER_COUNT - 1].cost);
+			failureCount++;
+			break;
+		}
+	}
 
-	// Start the algorithm to find the way back to the source
-	int stepsBack = getWayBack(hConsole, elementField, startPosition, nextCoord, speed);
+	freeBuilding(maze);
+	freeBuilding(packed);
 
-	SetConsoleCursorPosition(hConsole, dimension);
-	printf(D_FGREEN BBLACK"Shortes way to destination in %d steps\n"DEFAULT_COLOR, stepsBack);
-	Sleep(SHOW_SETTINGS_TIME);
+	return failureCount;
 }
 
 /// <summary>
-/// You do not talk about Fight Club!
-/// Calculate the next coordination for the maze and compare all types from the field
+/// Follow a way through a building and check every step, the cost and the destination at its end
 /// </summary>
-/// <param name="markField">Maze field with all types and tag values</param>
-/// <param name="currentCoord">Coordination to calculate all directions</param>
-/// <param name="latestCoord">Coordination to compare with possible next step</param>
-/// <returns>Coordination when all conditions for the first Trmaux' rule are passed</returns>
-COORD firstRule(element** markField, COORD currentCoord, COORD latestCoord)
+/// <param name="maze">the building</param>
+/// <param name="startPosition">the source position with level</param>
+/// <param name="result">of the solver</param>
+/// <param name="path">the way of the solver</param>
+/// <param name="reason">receives the description of the first error</param>
+/// <returns>True when the way is valid</returns>
+bool checkBuildingPath(building* maze, buildingCoord startPosition, solveResult result, packedPath* path, char* reason)
 {
-	// Check all direction in the following sequence 
-	/*
-			Third
-			  ^
-			  |
-	Fourth < - - > Second
-			  |
-			  v
-			First
-	*/
+	long long cell = getBuildingCell(maze, startPosition);
+	long long cost = 0;
 
-	// Check bottom direction is not the latest position and not a wall
-	if ((markField[currentCoord.Y + 1][currentCoord.X].type != Wall)
-		&& (currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X))
+	if (path->length != result.stepsBack)
 	{
-		// Check bottem direction is not a tag otherwise call second rule
-		if (markField[currentCoord.Y + 1][currentCoord.X].type != Marker)
-		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
-		else
-		{
-			// The next position is a tag so check all other tags value
-			return secondRule(markField, currentCoord);
-		}
+		snprintf(reason, VERIFY_REASON_SIZE, "the way has %lld moves but %lld steps back", path->length, result.stepsBack);
+		return FALSE;
 	}
 
-	// Check right direction is not the latest position and not a wall
-	else if ((markField[currentCoord.Y][currentCoord.X + 1].type != Wall)
-		&& (currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X))
+	for (long long index = 0; index < path->length; index++)
 	{
-		// Check right direction is not a tag otherwise call second rule
-		if (markField[currentCoord.Y][currentCoord.X + 1].type != Marker)
-		{
-			currentCoord.X++;
-			return currentCoord;
-		}
-		else
+		int direction = getPathMove(path, index);
+		long long nextCell;
+
+		if (direction >= BUILDING_DIRECTIONS || isBuildingStep(maze, cell, direction, &nextCell) != TRUE)
 		{
-			// The next position is a tag so check all other tags value
-			return secondRule(markField, currentCoord);
+			buildingCoord coord = getBuildingCoord(maze, cell);
+			snprintf(reason, VERIFY_REASON_SIZE, "move %lld leaves [ %d | %d | %d ] through a wall", index, coord.X, coord.Y, coord.Z);
+			return FALSE;
 		}
+
+		cell = nextCell;
+		cost += buildingCosts[BUILDING_CODE(maze, cell)];
 	}
 
-	// Check top direction is not the latest position and not a wall
-	else if ((markField[currentCoord.Y - 1][currentCoord.X].type != Wall)
-		&& (currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X))
+	if (BUILDING_CODE(maze, cell) != BuildingDestination)
 	{
-		// Check top direction is not a tag otherwise call second rule
-		if (markField[currentCoord.Y - 1][currentCoord.X].type != Marker)
-		{
-			currentCoord.Y--;
-			return currentCoord;
-		}
-		else
-		{
-			// The next position is a tag so check all other tags value
-			return secondRule(markField, currentCoord);
-		}
+		snprintf(reason, VERIFY_REASON_SIZE, "the way ends before the destination");
+		return FALSE;
 	}
 
-	// Check left direction is not the latest position and not a wall
-	else if ((markField[currentCoord.Y][currentCoord.X - 1].type != Wall)
-		&& (currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X))
+	if (cost != result.cost)
 	{
-		// Check left direction is not a tag otherwise call second rule
-		if (markField[currentCoord.Y][currentCoord.X - 1].type != Marker)
+		snprintf(reason, VERIFY_REASON_SIZE, "the way costs %lld instead of %lld", cost, result.cost);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/// <summary>
+/// Command line of the differential check of all solvers:
+/// verify [-seed N] [-count N] [-size width height] [-baseline file] [-threshold percent] [-record]
+/// Random mazes are generated, every solver runs with the full and the on-demand classification and every way is checked.
+/// Ways of optimal solvers must be as cheap as the reference, both classifications must give the same result,
+/// and no solver may become slower than the baseline of this machine by more than the threshold.
+/// </summary>
+/// <param name="argc">count of the arguments</param>
+/// <param name="argv">arguments of the application</param>
+/// <returns>Exit code, 0 when every check passed</returns>
+int runVerify(int argc, char* argv[])
+{
+	generatorSettings settings = { 0 };
+	settings.width = VERIFY_WIDTH;
+	settings.height = VERIFY_HEIGHT;
+
+	unsigned long long seed = GENERATOR_SEED;
+	int mazeCount = VERIFY_COUNT;
+	int threshold = VERIFY_THRESHOLD;
+	bool isRecording = FALSE;
+	char baselineName[FILENAME_MAX];
+	char computerName[MAX_COMPUTERNAME_LENGTH + 1] = "local";
+	DWORD computerNameSize = sizeof(computerName);
+
+	// The baseline belongs to the machine it was recorded on
+	GetComputerNameA(computerName, &computerNameSize);
+	snprintf(baselineName, FILENAME_MAX, VERIFY_BASELINE_FILE, computerName);
+
+	for (int index = 2; index < argc; index++)
+	{
+		if (strcmp(argv[index], "-seed") == 0 && index + 1 < argc)
+			seed = strtoull(argv[++index], NULL, 10);
+		else if (strcmp(argv[index], "-count") == 0 && index + 1 < argc)
+			mazeCount = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-size") == 0 && index + 2 < argc)
 		{
-			currentCoord.X--;
-			return currentCoord;
+			settings.width = atoll(argv[++index]);
+			settings.height = atoll(argv[++index]);
 		}
+		else if (strcmp(argv[index], "-baseline") == 0 && index + 1 < argc)
+			strcpy_s(baselineName, FILENAME_MAX, argv[++index]);
+		else if (strcmp(argv[index], "-threshold") == 0 && index + 1 < argc)
+			threshold = atoi(argv[++index]);
+		else if (strcmp(argv[index], "-record") == 0)
+			isRecording = TRUE;
 		else
 		{
-			// The next position is a tag so check all other tags value
-			return secondRule(markField, currentCoord);
+			printf("Error - unknown verify option %s\n", argv[index]);
+			return 1;
 		}
 	}
 
-	return currentCoord;
-}
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
 
-/// <summary>
-/// You do !NOT! talk about Fight Club!
-/// When step on a tag element check all others and go to this direction with the lowest tag value
-/// </summary>
-/// <param name="markField">Maze field with all types and tag values</param>
-/// <param name="currentCoord">Coordination to get present position</param>
-/// <returns>Coordination when all conditions for the second Trmaux' rule are passed - returns 0:0 if maze is not solvable</returns>
-COORD secondRule(element** markField, COORD currentCoord)
-{
-	int botDirection = 0;
-	int rightDirection = 0;
-	int topDirection = 0;
-	int leftDirection = 0;
+	// Summed solve time of every solver, with the full and the on-demand classification
+	long long solveTicks[SOLVER_POLICY_COUNT][2] = { 0 };
+	int failures[SOLVER_POLICY_COUNT] = { 0 };
+	int checkCount = 0;
+	int failureCount = 0;
+	COORD startPosition = { 1, 1 };
 
-	// Check if bottom is a marker and count the value
-	if (markField[currentCoord.Y + 1][currentCoord.X].type == Marker)
+	for (int maze = 0; maze < mazeCount; maze++)
 	{
-		botDirection++;
+		// Vary loops, rooms and destination, every second maze gets terrain costs
+		settings.seed = seed + maze;
+		settings.loopPercent = (maze % 3) * 10;
+		settings.roomPercent = (maze % 2) * 5;
+		settings.destination = (destinationPlacement)(maze % 3);
 
-		if (markField[currentCoord.Y + 1][currentCoord.X].markOne == TRUE)
-			botDirection++;
+		if (generateMaze(VERIFY_MAZE_FILE, settings) != TRUE)
+			return 1;
 
-		if (markField[currentCoord.Y + 1][currentCoord.X].markTwo == TRUE)
-			botDirection++;
+		COORD dimension = { 0 };
+		char** field = scanFieldFromPath(VERIFY_MAZE_FILE, &dimension);
 
-		// When bottom is a marker with value 0 return bottom 
-		if (botDirection == 1)
+		// The maze is far below PARSER_CHUNK_MIN, so the parser gets every count of chunks explicitly
+		failureCount += verifyTextParser(VERIFY_MAZE_FILE, dimension, settings.seed);
+		checkCount += VERIFY_PARSER_CHECKS;
+
+		if (maze % 2 == 1)
+			addTerrainCosts(field, dimension, settings.seed);
+
+		element** mazeContent = getMazeContent(dimension, field);
+		long long referenceCost = getReferenceCost(field, dimension, startPosition);
+
+		for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
 		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
-	}
-	// Check if right is a marker and count the value
-	if (markField[currentCoord.Y][currentCoord.X + 1].type == Marker)
-	{
-		rightDirection++;
+			char reason[VERIFY_REASON_SIZE] = "";
+			solveResult results[2] = { 0 };
+			packedPath paths[2] = { { PATH_MOVE_BITS }, { PATH_MOVE_BITS } };
 
-		if (markField[currentCoord.Y][currentCoord.X + 1].markOne == TRUE)
-			rightDirection++;
+			for (int mode = 0; mode < 2; mode++)
+			{
+				long long bestTicks = LLONG_MAX;
 
-		if (markField[currentCoord.Y][currentCoord.X + 1].markTwo == TRUE)
-			rightDirection++;
+				for (int repeat = 0; repeat < POLICY_BENCH_REPEAT; repeat++)
+				{
+					LARGE_INTEGER startTicks;
+					LARGE_INTEGER endTicks;
 
-		// When right is a marker with value 0 return right 
-		if (rightDirection == 1)
+					QueryPerformanceCounter(&startTicks);
+
+					// The on-demand classification is part of the solve, the full one is done once per maze
+					element** content = mode == 0 ? mazeContent : getMazeContentOnDemand(dimension);
+
+					paths[mode].length = 0;
+					policySolver solve = mode == 0 ? solverPolicies[policy].solve : solverPolicies[policy].solveOnDemand;
+					results[mode] = solve(content, field, dimension, startPosition, &paths[mode], NULL);
+
+					QueryPerformanceCounter(&endTicks);
+
+					if (mode == 0)
+					{
+						resetMazeContent(mazeContent, dimension);
+					}
+					else
+					{
+						free(content[0]);
+						free(content);
+					}
+
+					if (endTicks.QuadPart - startTicks.QuadPart < bestTicks)
+						bestTicks = endTicks.QuadPart - startTicks.QuadPart;
+				}
+
+				solveTicks[policy][mode] += bestTicks;
+			}
+
+			// Check the way of the full classification, the on-demand one must be identical
+			bool isValid = checkSolvedPath(field, dimension, startPosition, results[0], &paths[0], step_square4, squareMoveNames, reason);
+
+			if (isValid && results[0].status == SolveFound && referenceCost < 0)
+			{
+				snprintf(reason, VERIFY_REASON_SIZE, "found a way where the reference has none");
+				isValid = FALSE;
+			}
+
+			if (isValid && solverPolicies[policy].isOptimal && referenceCost >= 0
+				&& (results[0].status != SolveFound || results[0].cost != referenceCost))
+			{
+				snprintf(reason, VERIFY_REASON_SIZE, "%s with cost %lld, the reference costs %lld",
+					solveStatusNames[results[0].status], results[0].cost, referenceCost);
+				isValid = FALSE;
+			}
+
+			bool isSameWay = paths[0].length == paths[1].length;
+
+			for (long long index = 0; isSameWay && results[0].status == SolveFound && index < paths[0].length; index++)
+			{
+				isSameWay = getPathMove(&paths[0], index) == getPathMove(&paths[1], index);
+			}
+
+			if (isValid && (results[0].status != results[1].status || results[0].steps != results[1].steps
+				|| results[0].stepsBack != results[1].stepsBack || results[0].cost != results[1].cost || isSameWay != TRUE))
+			{
+				snprintf(reason, VERIFY_REASON_SIZE, "on-demand classification gives %s after %lld steps instead of %s after %lld steps",
+					solveStatusNames[results[1].status], results[1].steps, solveStatusNames[results[0].status], results[0].steps);
+				isValid = FALSE;
+			}
+
+			// Only the Tremaux' policies have checkpoints
+			if (isValid && solverPolicies[policy].solve != dijkstra && results[0].status == SolveFound)
+				isValid = verifyResume(mazeContent, field, dimension, startPosition, policy, results[0], &paths[0], reason);
+
+			if (isValid != TRUE)
+			{
+				printf("FAIL seed %llu %s: %s\n", settings.seed, solverPolicies[policy].name, reason);
+				failures[policy]++;
+				failureCount++;
+			}
+
+			checkCount++;
+			free(paths[0].moves);
+			free(paths[1].moves);
+		}
+
+		// Every grid topology on the same maze and a building with the same seed
+		failureCount += verifyTopologies(field, dimension, startPosition, referenceCost, settings.seed);
+		checkCount += TOPOLOGY_MODE_COUNT * TOPOLOGY_SOLVER_COUNT;
+		failureCount += verifyBuilding(settings.seed, maze);
+		checkCount += VERIFY_BUILDING_CHECKS;
+
+		for (int index = 0; index < dimension.Y; index++)
 		{
-			currentCoord.X++;
-			return currentCoord;
+			free(mazeContent[index]);
+			free(field[index]);
 		}
+
+		free(mazeContent);
+		free(field);
 	}
-	// Check if top is a markerand count the value
-	if (markField[currentCoord.Y - 1][currentCoord.X].type == Marker)
-	{
-		topDirection++;
 
-		if (markField[currentCoord.Y - 1][currentCoord.X].markOne == TRUE)
-			topDirection++;
+	remove(VERIFY_MAZE_FILE);
+	remove(VERIFY_TEXT_FILE);
+	remove(VERIFY_CHECKPOINT_FILE);
+	remove(VERIFY_BUILDING_FILE);
+	remove(VERIFY_PACKED_FILE);
 
-		if (markField[currentCoord.Y - 1][currentCoord.X].markTwo == TRUE)
-			topDirection++;
+	// Compare the timings with the baseline of this machine or record a new one
+	double baseline[SOLVER_POLICY_COUNT][2];
+	bool hasBaseline = isRecording != TRUE && readVerifyBaseline(baselineName, baseline);
 
-		// When top is a marker with value 0 return top 
-		if (topDirection == 1)
+	printf("%-16s %8s %12s %12s %12s %12s\n", "policy", "failed", "ms", "baseline", "lazy ms", "baseline");
+
+	for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
+	{
+		double milliseconds[2];
+
+		for (int mode = 0; mode < 2; mode++)
 		{
-			currentCoord.Y--;
-			return currentCoord;
+			milliseconds[mode] = (double)solveTicks[policy][mode] * 1000.0 / (double)frequency.QuadPart;
+
+			if (hasBaseline && baseline[policy][mode] >= 0
+				&& milliseconds[mode] > baseline[policy][mode] * (100 + threshold) / 100.0 + VERIFY_TIME_SLACK)
+			{
+				printf("FAIL %s%s: %.3fms is more than %d%% slower than the baseline %.3fms\n", solverPolicies[policy].name,
+					mode == 0 ? "" : " -lazy", milliseconds[mode], threshold, baseline[policy][mode]);
+				failureCount++;
+			}
+
+			if (hasBaseline != TRUE)
+				baseline[policy][mode] = -1;
 		}
+
+		printf("%-16s %8d %12.3f %12.3f %12.3f %12.3f\n", solverPolicies[policy].name, failures[policy],
+			milliseconds[0], baseline[policy][0], milliseconds[1], baseline[policy][1]);
+
+		baseline[policy][0] = milliseconds[0];
+		baseline[policy][1] = milliseconds[1];
 	}
-	// Check if left is a marker and count the value
-	if (markField[currentCoord.Y][currentCoord.X - 1].type == Marker)
-	{
-		leftDirection++;
 
-		if (markField[currentCoord.Y][currentCoord.X - 1].markOne == TRUE)
-			leftDirection++;
+	if (isRecording && writeVerifyBaseline(baselineName, baseline) != TRUE)
+		return 1;
 
-		if (markField[currentCoord.Y][currentCoord.X - 1].markTwo == TRUE)
-			leftDirection++;
+	printf("%d checks on %d mazes, %d failed%s\n", checkCount, mazeCount, failureCount,
+		isRecording ? ", baseline recorded" : hasBaseline ? "" : ", no baseline - record one with -record");
 
-		// When left is a marker with value 0 return left 
-		if (leftDirection == 1)
+	return failureCount == 0 ? 0 : 1;
+}
+
+/// <summary>
+/// Turn some corridors of a generated maze into terrain with costs 2 to 9
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1 and X</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="seed">of the random numbers</param>
+void addTerrainCosts(char** field, COORD dimension, unsigned long long seed)
+{
+	unsigned long long state = seed * 0x9E3779B97F4A7C15ULL + 1;
+
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		for (int indexX = 0; indexX < dimension.X; indexX++)
 		{
-			currentCoord.X--;
-			return currentCoord;
+			unsigned long long random = nextRandom(&state);
+
+			if (field[indexY][indexX] == '0' && random % 100 < VERIFY_TERRAIN_PERCENT)
+				field[indexY][indexX] = (char)('2' + (random >> 32) % (TERRAIN_COST_MAX - 1));
 		}
 	}
+}
 
-	// Compare all values with bottom tag value
-	if (botDirection > 0 && botDirection < LIMIT_STEPS_ON_MARKER)
+/// <summary>
+/// Cost of the cheapest way with a plain queue, positions are queued again whenever they get cheaper.
+/// Slow but simple, so it does not share any idea with the solvers.
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <returns>Cost of the cheapest way to a destination - returns -1 if there is none</returns>
+long long getReferenceCost(char** field, COORD dimension, COORD startPosition)
+{
+	long long cellCount = (long long)dimension.X * dimension.Y;
+	long long* costs = (long long*)malloc((size_t)cellCount * sizeof(long long));
+	long long* queue = (long long*)malloc((size_t)cellCount * sizeof(long long));
+	bool* isQueued = (bool*)calloc((size_t)cellCount, sizeof(bool));
+
+	if (costs == NULL || queue == NULL || isQueued == NULL)
 	{
-		if (rightDirection <= 0 && topDirection <= 0 && leftDirection <= 0)
-		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
-		else if (botDirection <= rightDirection)
-		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
-		else if (botDirection <= topDirection)
-		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
-		else if (botDirection <= leftDirection)
-		{
-			currentCoord.Y++;
-			return currentCoord;
-		}
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
 	}
-	// Compare all values with right tag value
-	if (rightDirection > 0 && rightDirection < LIMIT_STEPS_ON_MARKER)
+
+	for (long long cell = 0; cell < cellCount; cell++)
 	{
-		if (topDirection <= 0 && leftDirection <= 0)
-		{
-			currentCoord.X++;
-			return currentCoord;
-		}
-		else if (rightDirection <= topDirection)
-		{
-			currentCoord.X++;
-			return currentCoord;
-		}
-		else if (rightDirection <= leftDirection)
-		{
-			currentCoord.X++;
-			return currentCoord;
-		}
+		costs[cell] = LLONG_MAX;
 	}
-	// Compare all values with top tag value
-	if (topDirection > 0 && topDirection < LIMIT_STEPS_ON_MARKER)
+
+	// Ring buffer, a position is at most once in the queue
+	long long queueHead = 0;
+	long long queueCount = 1;
+	long long startCell = (long long)startPosition.Y * dimension.X + startPosition.X;
+
+	costs[startCell] = 0;
+	queue[0] = startCell;
+	isQueued[startCell] = TRUE;
+
+	while (queueCount > 0)
 	{
-		if (leftDirection <= 0)
-		{
-			currentCoord.Y--;
-			return currentCoord;
-		}
-		else if (topDirection <= leftDirection)
+		long long cell = queue[queueHead];
+		queueHead = (queueHead + 1) % cellCount;
+		queueCount--;
+		isQueued[cell] = FALSE;
+
+		int indexX = (int)(cell % dimension.X);
+		int indexY = (int)(cell / dimension.X);
+
+		// The way ends at the first destination
+		if (field[indexY][indexX] == 'X')
+			continue;
+
+		for (int direction = 0; direction < 4; direction++)
 		{
-			currentCoord.Y--;
-			return currentCoord;
+			int nextX = indexX + directionOffsets[direction].X;
+			int nextY = indexY + directionOffsets[direction].Y;
+
+			if (nextX < 0 || nextY < 0 || nextX >= dimension.X || nextY >= dimension.Y || field[nextY][nextX] == '1')
+				continue;
+
+			long long neighbour = (long long)nextY * dimension.X + nextX;
+			long long nextCost = costs[cell] + getTerrainCost(field[nextY][nextX]);
+
+			if (nextCost < costs[neighbour])
+			{
+				costs[neighbour] = nextCost;
+
+				if (isQueued[neighbour] != TRUE)
+				{
+					queue[(queueHead + queueCount) % cellCount] = neighbour;
+					queueCount++;
+					isQueued[neighbour] = TRUE;
+				}
+			}
 		}
 	}
-	// Compare all values with left tag value
-	if (leftDirection > 0 && leftDirection < LIMIT_STEPS_ON_MARKER)
+
+	long long referenceCost = -1;
+
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
 	{
-		currentCoord.X--;
-		return currentCoord;
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
+			long long cost = costs[(long long)indexY * dimension.X + indexX];
+
+			if (field[indexY][indexX] == 'X' && cost != LLONG_MAX && (referenceCost < 0 || cost < referenceCost))
+				referenceCost = cost;
+		}
 	}
 
-	// When stepping into this the maze is not solvable
-	currentCoord.X = 0;
-	currentCoord.Y = 0;
+	free(costs);
+	free(queue);
+	free(isQueued);
 
-	return currentCoord;
+	return referenceCost;
 }
 
 /// <summary>
-/// Helper to get the shortes way back to source from destination with the tagged maze content
+/// Check the way of a solver: it starts at the source, every step is a step of the topology to a neighbour which is no wall,
+/// it ends at the destination of the result and length and cost fit to the result
 /// </summary>
-/// <param name="markField">maze with the markings and their values</param>
-/// <param name="currentCoord">Coordination to get present position</param>
-/// <param name="latestCoord">Coordination to compare with possible next step</param>
-/// <returns>Coordination with the next step to get back to source - returns latest coordination if something went wrong</returns>
-COORD getNextStepBack(element** markField, COORD currentCoord, COORD latestCoord)
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="result">status, steps and cost of the solver</param>
+/// <param name="path">packed way of the solver</param>
+/// <param name="step">step of the topology, step_square4 for the four directions of directionOffsets</param>
+/// <param name="moveNames">names of the directions for the failure</param>
+/// <param name="reason">buffer with VERIFY_REASON_SIZE characters for the failure</param>
+/// <returns>True when the way is valid or the solver found no way</returns>
+bool checkSolvedPath(char** field, COORD dimension, COORD startPosition, solveResult result, packedPath* path, topologyStep step, const char* const* moveNames, char* reason)
 {
-	// Check bottom is a marker with only one tag and not latest step
-	if ((currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
-		&& (markField[currentCoord.Y + 1][currentCoord.X].type == Marker)
-		&& (markField[currentCoord.Y + 1][currentCoord.X].markOne == TRUE)
-		&& (markField[currentCoord.Y + 1][currentCoord.X].markTwo == FALSE))
-	{
-		currentCoord.Y++;
-		return currentCoord;
-	}
+	if (result.status != SolveFound)
+		return TRUE;
 
-	// Check right is a marker with only one tag and not latest step
-	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X)
-		&& (markField[currentCoord.Y][currentCoord.X + 1].type == Marker)
-		&& (markField[currentCoord.Y][currentCoord.X + 1].markOne == TRUE)
-		&& (markField[currentCoord.Y][currentCoord.X + 1].markTwo == FALSE))
+	if (path->start.X != startPosition.X || path->start.Y != startPosition.Y || path->length != result.stepsBack)
 	{
-		currentCoord.X++;
-		return currentCoord;
+		snprintf(reason, VERIFY_REASON_SIZE, "way of %lld steps from %d:%d instead of %lld steps from %d:%d",
+			path->length, path->start.X, path->start.Y, result.stepsBack, startPosition.X, startPosition.Y);
+		return FALSE;
 	}
 
-	// Check top is a marker with only one tag and not latest step
-	else if ((currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
-		&& (markField[currentCoord.Y - 1][currentCoord.X].type == Marker)
-		&& (markField[currentCoord.Y - 1][currentCoord.X].markOne == TRUE)
-		&& (markField[currentCoord.Y - 1][currentCoord.X].markTwo == FALSE))
+	COORD currentCoord = startPosition;
+	long long cost = 0;
+
+	for (long long index = 0; index < path->length; index++)
 	{
-		currentCoord.Y--;
-		return currentCoord;
+		int direction = getPathMove(path, index);
+		COORD nextCoord;
+
+		if (step(field, dimension, currentCoord, direction, &nextCoord) != TRUE)
+		{
+			snprintf(reason, VERIFY_REASON_SIZE, "step %lld %s from %d:%d is not possible", index + 1,
+				moveNames[direction], currentCoord.X, currentCoord.Y);
+			return FALSE;
+		}
+
+		currentCoord = nextCoord;
+		cost += getTerrainCost(field[currentCoord.Y][currentCoord.X]);
 	}
 
-	// Check left is a marker with only one tag and not latest step
-	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X)
-		&& (markField[currentCoord.Y][currentCoord.X - 1].type == Marker)
-		&& (markField[currentCoord.Y][currentCoord.X - 1].markOne == TRUE)
-		&& (markField[currentCoord.Y][currentCoord.X - 1].markTwo == FALSE))
+	if (field[currentCoord.Y][currentCoord.X] != 'X' || currentCoord.X != result.destination.X || currentCoord.Y != result.destination.Y)
 	{
-		currentCoord.X--;
-		return currentCoord;
+		snprintf(reason, VERIFY_REASON_SIZE, "way ends at %d:%d instead of the destination %d:%d",
+			currentCoord.X, currentCoord.Y, result.destination.X, result.destination.Y);
+		return FALSE;
 	}
 
-	// If there is no marker with one tag, check for the next corridor which is not the latest step
-	if ((currentCoord.Y + 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
-		&& (markField[currentCoord.Y + 1][currentCoord.X].type == Corridor))
+	if (cost != result.cost)
 	{
-		currentCoord.Y++;
-		return currentCoord;
+		snprintf(reason, VERIFY_REASON_SIZE, "way costs %lld instead of %lld", cost, result.cost);
+		return FALSE;
 	}
-	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X + 1 != latestCoord.X)
-		&& (markField[currentCoord.Y][currentCoord.X + 1].type == Corridor))
+
+	return TRUE;
+}
+
+/// <summary>
+/// Read the timings of the baseline, every line holds the name of a solver and the milliseconds of both classifications
+/// </summary>
+/// <param name="fileName">of the baseline</param>
+/// <param name="baseline">milliseconds per solver in the order of the registry, -1 for solvers without a line</param>
+/// <returns>True when the baseline was read</returns>
+bool readVerifyBaseline(char* fileName, double baseline[][2])
+{
+	FILE* file;
+
+	for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
 	{
-		currentCoord.X++;
-		return currentCoord;
+		baseline[policy][0] = -1;
+		baseline[policy][1] = -1;
 	}
-	else if ((currentCoord.Y - 1 != latestCoord.Y || currentCoord.X != latestCoord.X)
-		&& (markField[currentCoord.Y - 1][currentCoord.X].type == Corridor))
+
+	if (fopen_s(&file, fileName, "r") != 0)
+		return FALSE;
+
+	char line[BUFFER_SIZE * 4];
+
+	while (fgets(line, sizeof(line), file) != NULL)
 	{
-		currentCoord.Y--;
-		return currentCoord;
+		char* context = NULL;
+		char* name = strtok_s(line, " \t\r\n", &context);
+		char* milliseconds = strtok_s(NULL, " \t\r\n", &context);
+		char* lazyMilliseconds = strtok_s(NULL, " \t\r\n", &context);
+		int policy = name != NULL ? findSolverPolicy(name) : -1;
+
+		if (policy >= 0 && milliseconds != NULL && lazyMilliseconds != NULL)
+		{
+			baseline[policy][0] = atof(milliseconds);
+			baseline[policy][1] = atof(lazyMilliseconds);
+		}
 	}
-	else if ((currentCoord.Y != latestCoord.Y || currentCoord.X - 1 != latestCoord.X)
-		&& (markField[currentCoord.Y][currentCoord.X - 1].type == Corridor))
+
+	fclose(file);
+
+	return TRUE;
+}
+
+/// <summary>
+/// Write the timings of all solvers as new baseline
+/// </summary>
+/// <param name="fileName">of the baseline</param>
+/// <param name="baseline">milliseconds per solver in the order of the registry</param>
+/// <returns>True when the baseline was written</returns>
+bool writeVerifyBaseline(char* fileName, double baseline[][2])
+{
+	FILE* file;
+
+	if (fopen_s(&file, fileName, "w") != 0)
 	{
-		currentCoord.X--;
-		return currentCoord;
+		printf("Error - can not write the baseline %s\n", fileName);
+		return FALSE;
 	}
-	// Return latest coordination if there is no possible direction 
-	else
+
+	for (int policy = 0; policy < SOLVER_POLICY_COUNT; policy++)
 	{
-		// Something went wrong
-		return latestCoord;
+		fprintf(file, "%s %.3f %.3f\n", solverPolicies[policy].name, baseline[policy][0], baseline[policy][1]);
 	}
+
+	bool isWritten = ferror(file) == 0;
+	fclose(file);
+
+	return isWritten;
 }
 
+#if INSTRUMENTATION
 /// <summary>
-/// Calculate the shortest way from destination to source in the maze. Thourgh the simply highlighted tags.
+/// Start the timer and the cycle counter of one phase
 /// </summary>
-/// <param name="hConsole">Console to print </param>
-/// <param name="markField">maze with the markings and their values</param>
-/// <param name="startPosition">Source must be adjusted back to</param>
-/// <param name="mazeDesination">Destination of the maze, where to start from</param>
-/// <param name="speed">Delay time in milliseconds</param>
-/// <returns>Steps number from destination to source coordination</returns>
-int getWayBack(HANDLE hConsole, element** markField, COORD startPosition, COORD mazeDesination, int speed)
+/// <param name="phase">which is going to be measured</param>
+void instrPhaseBegin(instrPhase phase)
 {
-	COORD nextCoord = mazeDesination;
-	COORD latestCoord = { 0 };
-	COORD currentCoord = { 0 };
-	int countBack = 0;
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
 
-	// Analyze the coordination until the current coordination is the source
-	while ((nextCoord.X != startPosition.X) || (nextCoord.Y != startPosition.Y))
-	{
-		currentCoord = nextCoord;
-		nextCoord = getNextStepBack(markField, currentCoord, latestCoord);
+	instr.phaseStartTicks[phase] = ticks.QuadPart;
+	instr.phaseStartCycles[phase] = __rdtsc();
+}
 
-		// When get back the latest coordination something went wrong
-		if (nextCoord.X == latestCoord.X && nextCoord.Y == latestCoord.Y)
-		{
-			printf("Error! - something went wrong when calculating the way back to source!\n");
-			exit(1);
-		}
+/// <summary>
+/// Stop the timer and the cycle counter of one phase and add up the elapsed time
+/// </summary>
+/// <param name="phase">which has been measured</param>
+void instrPhaseEnd(instrPhase phase)
+{
+	unsigned long long cycles = __rdtsc();
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
 
-		printObject2Console(hConsole, nextCoord, "X", FBLACK, BGREEN);
+	instr.phaseTicks[phase] += ticks.QuadPart - instr.phaseStartTicks[phase];
+	instr.phaseCycles[phase] += cycles - instr.phaseStartCycles[phase];
+}
 
-		latestCoord = currentCoord;
-		countBack++;
+/// <summary>
+/// Count the direction chosen for the next step
+/// </summary>
+/// <param name="currentCoord">position before the step</param>
+/// <param name="nextCoord">position after the step</param>
+void instrCountDirection(COORD currentCoord, COORD nextCoord)
+{
+	if (nextCoord.Y > currentCoord.Y)
+		instr.directionDown++;
+	else if (nextCoord.X > currentCoord.X)
+		instr.directionRight++;
+	else if (nextCoord.Y < currentCoord.Y)
+		instr.directionUp++;
+	else if (nextCoord.X < currentCoord.X)
+		instr.directionLeft++;
+}
+
+/// <summary>
+/// Write all counters and timers as JSON into the current working directory
+/// </summary>
+/// <param name="fileName">of the JSON output</param>
+void exportInstrumentation(char fileName[])
+{
+	static const char* phaseNames[PhaseCount] = { "load", "classify", "solve", "path" };
+
+	FILE* file;
+	errno_t errNo = fopen_s(&file, fileName, "w");
+
+	if (errNo != 0)
+	{
+		printf("Error - can not write the instrumentation to %s\n", fileName);
+		return;
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	fprintf(file, "{\n");
+	fprintf(file, "  \"counters\": {\n");
+	fprintf(file, "    \"steps\": %llu,\n", instr.steps);
+	fprintf(file, "    \"firstRuleCalls\": %llu,\n", instr.firstRuleCalls);
+	fprintf(file, "    \"secondRuleCalls\": %llu,\n", instr.secondRuleCalls);
+	fprintf(file, "    \"directionDown\": %llu,\n", instr.directionDown);
+	fprintf(file, "    \"directionRight\": %llu,\n", instr.directionRight);
+	fprintf(file, "    \"directionUp\": %llu,\n", instr.directionUp);
+	fprintf(file, "    \"directionLeft\": %llu,\n", instr.directionLeft);
+	fprintf(file, "    \"markOneTags\": %llu,\n", instr.markOneTags);
+	fprintf(file, "    \"markTwoTags\": %llu,\n", instr.markTwoTags);
+	fprintf(file, "    \"wayBackSteps\": %llu\n", instr.wayBackSteps);
+	fprintf(file, "  },\n");
+	fprintf(file, "  \"phases\": {\n");
+
+	for (int phase = 0; phase < PhaseCount; phase++)
+	{
+		double milliseconds = (double)instr.phaseTicks[phase] * 1000.0 / (double)frequency.QuadPart;
 
-		Sleep(speed);
+		fprintf(file, "    \"%s\": { \"ms\": %.3f, \"cycles\": %llu }%s\n",
+			phaseNames[phase], milliseconds, instr.phaseCycles[phase], phase + 1 < PhaseCount ? "," : "");
 	}
 
-	return countBack;
-}
\ No newline at end of file
+	fprintf(file, "  }\n");
+	fprintf(file, "}\n");
+
+	fclose(file);
+}
+#endif
@@ -0,0 +1,510 @@
+/*
+* Template of the solvers for one grid topology, this file is included once for every topology.
+* Before including define:
+*
+*	TOPOLOGY_NAME			suffix of the generated functions
+*	TOPOLOGY_DIRECTIONS		count of neighbours, the directions are ranked in this order like Down, Right, Up, Left
+*	TOPOLOGY_EVEN_OFFSETS	X and Y of every direction from an even row
+*	TOPOLOGY_ODD_OFFSETS	X and Y of every direction from an odd row, hex rows are shifted by half an element
+*	TOPOLOGY_OPPOSITE		index of the opposite direction of every direction
+*	TOPOLOGY_HEX			TRUE for hexagonal grids, FALSE for square grids
+*	TOPOLOGY_CORNERS		cornerCutting of diagonal steps in square grids
+*
+* Offsets, corner rule and distance are constants, so every topology gets its own neighbour loops without any runtime dispatch.
+* The solvers work on the scratch maze. Diagonal steps create small loops without any crossroad, so instead of the markers
+* around crossroads the Tremaux' solver marks the passages between neighbours, with two bits per direction and position.
+*/
+
+#define TOPOLOGY_JOIN(function, name) function##_##name
+#define TOPOLOGY_EXPAND(function, name) TOPOLOGY_JOIN(function, name)
+#define TOPOLOGY_FUNCTION(function) TOPOLOGY_EXPAND(function, TOPOLOGY_NAME)
+
+static const COORD TOPOLOGY_FUNCTION(topologyOffsets)[2][TOPOLOGY_DIRECTIONS] = { TOPOLOGY_EVEN_OFFSETS, TOPOLOGY_ODD_OFFSETS };
+static const int TOPOLOGY_FUNCTION(topologyOpposite)[TOPOLOGY_DIRECTIONS] = TOPOLOGY_OPPOSITE;
+
+bool TOPOLOGY_FUNCTION(step)(char** field, COORD dimension, COORD coord, int direction, COORD* nextCoord);
+static long long TOPOLOGY_FUNCTION(distance)(COORD from, COORD to);
+solveResult TOPOLOGY_FUNCTION(tremaux)(char** field, COORD dimension, COORD startPosition, packedPath* path);
+solveResult TOPOLOGY_FUNCTION(bfs)(char** field, COORD dimension, COORD startPosition, packedPath* path);
+solveResult TOPOLOGY_FUNCTION(astar)(char** field, COORD dimension, COORD startPosition, packedPath* path);
+static void TOPOLOGY_FUNCTION(followArrivals)(char** field, COORD dimension, unsigned char* arrivals, long long destinationCell,
+	COORD startPosition, solveResult* result, packedPath* path);
+
+/// <summary>
+/// One step of the topology: the neighbour has to be inside the maze, no wall and a diagonal step must follow the corner rule
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="coord">position before the step</param>
+/// <param name="direction">index of the direction in the ranking</param>
+/// <param name="nextCoord">position after the step</param>
+/// <returns>True when the step is possible</returns>
+bool TOPOLOGY_FUNCTION(step)(char** field, COORD dimension, COORD coord, int direction, COORD* nextCoord)
+{
+#if TOPOLOGY_HEX
+	COORD offset = TOPOLOGY_FUNCTION(topologyOffsets)[coord.Y & 1][direction];
+#else
+	COORD offset = TOPOLOGY_FUNCTION(topologyOffsets)[0][direction];
+#endif
+
+	nextCoord->X = coord.X + offset.X;
+	nextCoord->Y = coord.Y + offset.Y;
+
+	if (nextCoord->X < 0 || nextCoord->Y < 0 || nextCoord->X >= dimension.X || nextCoord->Y >= dimension.Y
+		|| field[nextCoord->Y][nextCoord->X] == '1')
+		return FALSE;
+
+#if !TOPOLOGY_HEX
+	// A diagonal step passes the two elements beside it
+	if (TOPOLOGY_DIRECTIONS == 8 && TOPOLOGY_CORNERS != CornerCutAlways && offset.X != 0 && offset.Y != 0)
+	{
+		int openSides = (field[coord.Y][nextCoord->X] != '1') + (field[nextCoord->Y][coord.X] != '1');
+
+		if (openSides < (TOPOLOGY_CORNERS == CornerCutNever ? 2 : 1))
+			return FALSE;
+	}
+#endif
+
+	return TRUE;
+}
+
+/// <summary>
+/// Fewest steps between two positions without walls, every step costs at least 1, so A* never overestimates
+/// </summary>
+/// <param name="from">first position</param>
+/// <param name="to">second position</param>
+/// <returns>Count of steps</returns>
+static long long TOPOLOGY_FUNCTION(distance)(COORD from, COORD to)
+{
+#if TOPOLOGY_HEX
+	// Cube coordinates of the shifted rows
+	long long fromQ = from.X - (from.Y - (from.Y & 1)) / 2;
+	long long toQ = to.X - (to.Y - (to.Y & 1)) / 2;
+	long long deltaQ = toQ - fromQ;
+	long long deltaR = (long long)to.Y - from.Y;
+
+	return (llabs(deltaQ) + llabs(deltaR) + llabs(deltaQ + deltaR)) / 2;
+#else
+	long long deltaX = llabs((long long)to.X - from.X);
+	long long deltaY = llabs((long long)to.Y - from.Y);
+
+	return TOPOLOGY_DIRECTIONS == 8 ? (deltaX > deltaY ? deltaX : deltaY) : deltaX + deltaY;
+#endif
+}
+
+/// <summary>
+/// Solve the maze with Tremaux' marks on the passages between neighbours and record the way back.
+/// Every pass through a passage adds a mark: a new position is left over a passage without mark in the ranking of the directions,
+/// a known position reached over a new passage is left back over this passage, otherwise the way goes back over the passage
+/// with one mark. The passages with one mark are the way from the source to the destination.
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+/// <returns>Status, the counted steps and the cost of the way</returns>
+solveResult TOPOLOGY_FUNCTION(tremaux)(char** field, COORD dimension, COORD startPosition, packedPath* path)
+{
+	solveResult result = { 0 };
+	long long cellCount = (long long)dimension.X * dimension.Y;
+	long long stepLimit = cellCount * SOLVER_STEP_LIMIT_FACTOR;
+	unsigned short* marks = (unsigned short*)calloc((size_t)cellCount, sizeof(unsigned short));
+	bool* isVisited = (bool*)calloc((size_t)cellCount, sizeof(bool));
+
+	if (marks == NULL || isVisited == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	COORD currentCoord = startPosition;
+	long long cell = (long long)startPosition.Y * dimension.X + startPosition.X;
+	bool isKnown = FALSE;
+	int arrival = -1;
+
+	isVisited[cell] = TRUE;
+	result.status = SolveFound;
+
+	while (field[currentCoord.Y][currentCoord.X] != 'X')
+	{
+		int direction = -1;
+		COORD nextCoord;
+
+		if (isKnown && PASSAGE_MARKS(marks[cell], TOPOLOGY_FUNCTION(topologyOpposite)[arrival]) == 1)
+		{
+			// Known position over a new passage, go back
+			direction = TOPOLOGY_FUNCTION(topologyOpposite)[arrival];
+			TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, direction, &nextCoord);
+		}
+
+		for (int candidate = 0; candidate < TOPOLOGY_DIRECTIONS && direction < 0; candidate++)
+		{
+			if (PASSAGE_MARKS(marks[cell], candidate) == 0 && TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, candidate, &nextCoord))
+				direction = candidate;
+		}
+
+		for (int candidate = 0; candidate < TOPOLOGY_DIRECTIONS && direction < 0; candidate++)
+		{
+			if (PASSAGE_MARKS(marks[cell], candidate) == 1 && TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, candidate, &nextCoord))
+				direction = candidate;
+		}
+
+		// Every passage was passed twice
+		if (direction < 0)
+		{
+			result.status = SolveNoSolution;
+			break;
+		}
+
+		long long nextCell = (long long)nextCoord.Y * dimension.X + nextCoord.X;
+
+		marks[cell] += (unsigned short)(1 << (direction * 2));
+		marks[nextCell] += (unsigned short)(1 << (TOPOLOGY_FUNCTION(topologyOpposite)[direction] * 2));
+
+		isKnown = isVisited[nextCell];
+		isVisited[nextCell] = TRUE;
+		arrival = direction;
+		currentCoord = nextCoord;
+		cell = nextCell;
+		result.steps++;
+
+		if (result.steps > stepLimit)
+		{
+			result.status = SolveStepLimit;
+			break;
+		}
+	}
+
+	if (result.status == SolveFound)
+	{
+		result.destination = currentCoord;
+
+		if (path != NULL)
+			path->length = 0;
+
+		// Follow the passages with one mark back to the source
+		int back = -1;
+
+		while (currentCoord.X != startPosition.X || currentCoord.Y != startPosition.Y)
+		{
+			int direction = -1;
+			COORD nextCoord;
+
+			for (int candidate = 0; candidate < TOPOLOGY_DIRECTIONS && direction < 0; candidate++)
+			{
+				if (candidate != back && PASSAGE_MARKS(marks[cell], candidate) == 1
+					&& TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, candidate, &nextCoord))
+					direction = candidate;
+			}
+
+			if (direction < 0 || result.stepsBack > stepLimit)
+			{
+				result.status = SolveNoWayBack;
+				break;
+			}
+
+			if (path != NULL)
+				appendPathMove(path, direction);
+
+			result.cost += getTerrainCost(field[currentCoord.Y][currentCoord.X]);
+			result.stepsBack++;
+			back = TOPOLOGY_FUNCTION(topologyOpposite)[direction];
+			currentCoord = nextCoord;
+			cell = (long long)currentCoord.Y * dimension.X + currentCoord.X;
+		}
+
+		// The way was recorded backwards from the destination
+		if (path != NULL && result.status == SolveFound)
+			reversePath(path, startPosition, TOPOLOGY_FUNCTION(topologyOpposite));
+	}
+
+	free(marks);
+	free(isVisited);
+
+	return result;
+}
+
+/// <summary>
+/// Breadth-first search for the way with the fewest steps, terrain costs are only summed up
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+/// <returns>Status, the reached positions as steps, the steps and the cost of the way</returns>
+solveResult TOPOLOGY_FUNCTION(bfs)(char** field, COORD dimension, COORD startPosition, packedPath* path)
+{
+	solveResult result = { 0 };
+	long long cellCount = (long long)dimension.X * dimension.Y;
+	long long* queue = (long long*)malloc((size_t)cellCount * sizeof(long long));
+	unsigned char* arrivals = (unsigned char*)malloc((size_t)cellCount);
+
+	if (queue == NULL || arrivals == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	memset(arrivals, TOPOLOGY_UNREACHED, (size_t)cellCount);
+
+	long long queueHead = 0;
+	long long queueTail = 1;
+	long long destinationCell = -1;
+
+	queue[0] = (long long)startPosition.Y * dimension.X + startPosition.X;
+	arrivals[queue[0]] = TOPOLOGY_SOURCE;
+
+	while (queueHead < queueTail && destinationCell < 0)
+	{
+		long long cell = queue[queueHead];
+		COORD currentCoord = { (SHORT)(cell % dimension.X), (SHORT)(cell / dimension.X) };
+
+		queueHead++;
+		result.steps++;
+
+		if (field[currentCoord.Y][currentCoord.X] == 'X')
+		{
+			destinationCell = cell;
+			break;
+		}
+
+		for (int direction = 0; direction < TOPOLOGY_DIRECTIONS; direction++)
+		{
+			COORD nextCoord;
+
+			if (TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, direction, &nextCoord) != TRUE)
+				continue;
+
+			long long neighbour = (long long)nextCoord.Y * dimension.X + nextCoord.X;
+
+			if (arrivals[neighbour] == TOPOLOGY_UNREACHED)
+			{
+				arrivals[neighbour] = (unsigned char)direction;
+				queue[queueTail] = neighbour;
+				queueTail++;
+			}
+		}
+	}
+
+	result.status = destinationCell < 0 ? SolveNoSolution : SolveFound;
+
+	if (destinationCell >= 0)
+		TOPOLOGY_FUNCTION(followArrivals)(field, dimension, arrivals, destinationCell, startPosition, &result, path);
+
+	free(queue);
+	free(arrivals);
+
+	return result;
+}
+
+/// <summary>
+/// A* for the cheapest way with terrain costs. The estimate is the fewest steps to the nearest destination,
+/// it grows by at most one per step, so the total of cost and estimate of the next position is at most
+/// TERRAIN_COST_MAX + 1 above the current one and a ring of buckets like in dijkstra() is enough as queue.
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+/// <returns>Status, the settled positions as steps, the steps and the cost of the way</returns>
+solveResult TOPOLOGY_FUNCTION(astar)(char** field, COORD dimension, COORD startPosition, packedPath* path)
+{
+	solveResult result = { 0 };
+	long long cellCount = (long long)dimension.X * dimension.Y;
+	long long* costs = (long long*)malloc((size_t)cellCount * sizeof(long long));
+	unsigned char* arrivals = (unsigned char*)malloc((size_t)cellCount);
+	costBucket buckets[ASTAR_BUCKETS] = { 0 };
+
+	// The estimate needs all destinations, with too many of them it is left out and A* becomes Dijkstra's algorithm
+	COORD targets[ASTAR_TARGETS];
+	int targetCount = 0;
+
+	for (int indexY = 0; indexY < dimension.Y; indexY++)
+	{
+		for (int indexX = 0; indexX < dimension.X; indexX++)
+		{
+			if (field[indexY][indexX] == 'X' && targetCount <= ASTAR_TARGETS)
+			{
+				if (targetCount < ASTAR_TARGETS)
+				{
+					targets[targetCount].X = (SHORT)indexX;
+					targets[targetCount].Y = (SHORT)indexY;
+				}
+
+				targetCount++;
+			}
+		}
+	}
+
+	if (targetCount > ASTAR_TARGETS)
+		targetCount = 0;
+
+	if (costs == NULL || arrivals == NULL)
+	{
+		printf("Error - Failed to reserve memory\n");
+		exit(1);
+	}
+
+	memset(arrivals, TOPOLOGY_UNREACHED, (size_t)cellCount);
+
+	long long startCell = (long long)startPosition.Y * dimension.X + startPosition.X;
+	long long destinationCell = -1;
+	long long queued = 1;
+	long long startEstimate = LLONG_MAX;
+
+	for (int target = 0; target < targetCount; target++)
+	{
+		long long estimate = TOPOLOGY_FUNCTION(distance)(startPosition, targets[target]);
+
+		if (estimate < startEstimate)
+			startEstimate = estimate;
+	}
+
+	if (targetCount == 0)
+		startEstimate = 0;
+
+	costs[startCell] = 0;
+	arrivals[startCell] = TOPOLOGY_SOURCE;
+	pushCostBucket(&buckets[startEstimate % ASTAR_BUCKETS], startCell);
+
+	for (long long currentTotal = startEstimate; queued > 0 && destinationCell < 0; currentTotal++)
+	{
+		costBucket* bucket = &buckets[currentTotal % ASTAR_BUCKETS];
+
+		// Positions with the same total are added to this bucket while it is read, they are read in this pass as well
+		long long entry;
+
+		for (entry = 0; entry < bucket->count; entry++)
+		{
+			long long cell = bucket->cells[entry];
+			COORD currentCoord = { (SHORT)(cell % dimension.X), (SHORT)(cell / dimension.X) };
+			long long estimate = targetCount == 0 ? 0 : LLONG_MAX;
+
+			for (int target = 0; target < targetCount; target++)
+			{
+				long long distance = TOPOLOGY_FUNCTION(distance)(currentCoord, targets[target]);
+
+				if (distance < estimate)
+					estimate = distance;
+			}
+
+			// Positions which got cheaper afterwards are still in the older bucket
+			if (costs[cell] + estimate != currentTotal)
+				continue;
+
+			result.steps++;
+
+			if (field[currentCoord.Y][currentCoord.X] == 'X')
+			{
+				destinationCell = cell;
+				break;
+			}
+
+			for (int direction = 0; direction < TOPOLOGY_DIRECTIONS; direction++)
+			{
+				COORD nextCoord;
+
+				if (TOPOLOGY_FUNCTION(step)(field, dimension, currentCoord, direction, &nextCoord) != TRUE)
+					continue;
+
+				long long neighbour = (long long)nextCoord.Y * dimension.X + nextCoord.X;
+				long long nextCost = costs[cell] + getTerrainCost(field[nextCoord.Y][nextCoord.X]);
+
+				if (arrivals[neighbour] == TOPOLOGY_UNREACHED || nextCost < costs[neighbour])
+				{
+					long long nextEstimate = targetCount == 0 ? 0 : LLONG_MAX;
+
+					for (int target = 0; target < targetCount; target++)
+					{
+						long long distance = TOPOLOGY_FUNCTION(distance)(nextCoord, targets[target]);
+
+						if (distance < nextEstimate)
+							nextEstimate = distance;
+					}
+
+					costs[neighbour] = nextCost;
+					arrivals[neighbour] = (unsigned char)direction;
+					pushCostBucket(&buckets[(nextCost + nextEstimate) % ASTAR_BUCKETS], neighbour);
+					queued++;
+				}
+			}
+		}
+
+		// The entries up to the destination are done, the rest of this bucket is not needed any more
+		queued -= entry;
+		bucket->count = 0;
+	}
+
+	result.status = destinationCell < 0 ? SolveNoSolution : SolveFound;
+
+	if (destinationCell >= 0)
+		TOPOLOGY_FUNCTION(followArrivals)(field, dimension, arrivals, destinationCell, startPosition, &result, path);
+
+	for (int bucket = 0; bucket < ASTAR_BUCKETS; bucket++)
+	{
+		free(buckets[bucket].cells);
+	}
+
+	free(costs);
+	free(arrivals);
+
+	return result;
+}
+
+/// <summary>
+/// Follow the arrival directions from the destination back to the source and record the way
+/// </summary>
+/// <param name="field">the scratch maze with 0, 1, X and the cost digits</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="arrivals">direction every position was reached with</param>
+/// <param name="destinationCell">index of the reached destination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="result">receives destination, steps and cost of the way</param>
+/// <param name="path">receives the way from source to destination, can be NULL</param>
+static void TOPOLOGY_FUNCTION(followArrivals)(char** field, COORD dimension, unsigned char* arrivals, long long destinationCell,
+	COORD startPosition, solveResult* result, packedPath* path)
+{
+	COORD currentCoord = { (SHORT)(destinationCell % dimension.X), (SHORT)(destinationCell / dimension.X) };
+
+	result->destination = currentCoord;
+
+	if (path != NULL)
+		path->length = 0;
+
+	for (long long cell = destinationCell; arrivals[cell] != TOPOLOGY_SOURCE; cell = (long long)currentCoord.Y * dimension.X + currentCoord.X)
+	{
+		// The opposite direction leads back to the previous position, in hex grids it depends on the row of this one
+		int back = TOPOLOGY_FUNCTION(topologyOpposite)[arrivals[cell]];
+		COORD previousCoord;
+
+		result->cost += getTerrainCost(field[currentCoord.Y][currentCoord.X]);
+		result->stepsBack++;
+
+		if (path != NULL)
+			appendPathMove(path, back);
+
+#if TOPOLOGY_HEX
+		COORD offset = TOPOLOGY_FUNCTION(topologyOffsets)[currentCoord.Y & 1][back];
+#else
+		COORD offset = TOPOLOGY_FUNCTION(topologyOffsets)[0][back];
+#endif
+
+		previousCoord.X = currentCoord.X + offset.X;
+		previousCoord.Y = currentCoord.Y + offset.Y;
+		currentCoord = previousCoord;
+	}
+
+	if (path != NULL)
+		reversePath(path, startPosition, TOPOLOGY_FUNCTION(topologyOpposite));
+}
+
+#undef TOPOLOGY_FUNCTION
+#undef TOPOLOGY_EXPAND
+#undef TOPOLOGY_JOIN
+#undef TOPOLOGY_NAME
+#undef TOPOLOGY_DIRECTIONS
+#undef TOPOLOGY_EVEN_OFFSETS
+#undef TOPOLOGY_ODD_OFFSETS
+#undef TOPOLOGY_OPPOSITE
+#undef TOPOLOGY_HEX
+#undef TOPOLOGY_CORNERS
@@ -0,0 +1,137 @@
+/*
+* Template of one Trmaux' solver policy, this file is included once for every instantiation.
+* Before including define:
+*
+*	POLICY_NAME		suffix of the generated functions
+*	POLICY_ORDER	ranking of the directions as indices of directionOffsets (0 = Down, 1 = Right, 2 = Up, 3 = Left)
+*	POLICY_TIE_LAST	FALSE to prefer the first of equal tagged markers in the ranking, TRUE to prefer the last one
+*	POLICY_LIMIT	maximum steps on a marker, like LIMIT_STEPS_ON_MARKER
+*
+* All parameters are constants, so the compiler creates a separate step loop for every policy without any runtime dispatch.
+* Every policy gets two solvers from TremauxSolve.h, tremaux for the maze content of getMazeContent() and tremauxOnDemand
+* for the one of getMazeContentOnDemand().
+*/
+
+#define POLICY_JOIN(function, name) function##_##name
+#define POLICY_EXPAND(function, name) POLICY_JOIN(function, name)
+#define POLICY_FUNCTION(function) POLICY_EXPAND(function, POLICY_NAME)
+
+static const int POLICY_FUNCTION(policyOrder)[4] = { POLICY_ORDER };
+
+static COORD POLICY_FUNCTION(policyFirstRule)(element** markField, COORD currentCoord, COORD latestCoord);
+static COORD POLICY_FUNCTION(policySecondRule)(element** markField, COORD currentCoord);
+static COORD POLICY_FUNCTION(policyNextStepBack)(element** markField, COORD currentCoord, COORD latestCoord);
+solveResult POLICY_FUNCTION(tremaux)(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint);
+solveResult POLICY_FUNCTION(tremauxOnDemand)(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint);
+
+/// <summary>
+/// First Trmaux' rule of the policy: go to the first direction in the ranking which is neither a wall nor the latest position
+/// </summary>
+/// <param name="markField">Maze field with all types and tag values</param>
+/// <param name="currentCoord">Coordination to calculate all directions</param>
+/// <param name="latestCoord">Coordination to compare with possible next step</param>
+/// <returns>Next coordination - returns 0:0 if maze is not solvable</returns>
+static COORD POLICY_FUNCTION(policyFirstRule)(element** markField, COORD currentCoord, COORD latestCoord)
+{
+	INSTR_COUNT(firstRuleCalls);
+
+	for (int rank = 0; rank < 4; rank++)
+	{
+		COORD offset = directionOffsets[POLICY_FUNCTION(policyOrder)[rank]];
+		COORD nextCoord = { currentCoord.X + offset.X, currentCoord.Y + offset.Y };
+
+		if (markField[nextCoord.Y][nextCoord.X].type == Wall
+			|| (nextCoord.X == latestCoord.X && nextCoord.Y == latestCoord.Y))
+			continue;
+
+		// Step on a marker needs the second rule
+		if (markField[nextCoord.Y][nextCoord.X].type != Marker)
+			return nextCoord;
+
+		return POLICY_FUNCTION(policySecondRule)(markField, currentCoord);
+	}
+
+	return currentCoord;
+}
+
+/// <summary>
+/// Second Trmaux' rule of the policy: go to the marker with the lowest tag value below the limit
+/// </summary>
+/// <param name="markField">Maze field with all types and tag values</param>
+/// <param name="currentCoord">Coordination to get present position</param>
+/// <returns>Next coordination - returns 0:0 if maze is not solvable</returns>
+static COORD POLICY_FUNCTION(policySecondRule)(element** markField, COORD currentCoord)
+{
+	INSTR_COUNT(secondRuleCalls);
+
+	COORD bestCoord = { 0 };
+	int bestValue = POLICY_LIMIT;
+
+	for (int rank = 0; rank < 4; rank++)
+	{
+		COORD offset = directionOffsets[POLICY_FUNCTION(policyOrder)[rank]];
+		element next = markField[currentCoord.Y + offset.Y][currentCoord.X + offset.X];
+
+		if (next.type != Marker)
+			continue;
+
+		int value = 1 + next.markOne + next.markTwo;
+
+		if (value < bestValue || (POLICY_TIE_LAST && value == bestValue && value < POLICY_LIMIT))
+		{
+			bestValue = value;
+			bestCoord.X = currentCoord.X + offset.X;
+			bestCoord.Y = currentCoord.Y + offset.Y;
+		}
+	}
+
+	return bestCoord;
+}
+
+/// <summary>
+/// Next step of the policy to get back to the source, first over the markers with one tag then over the corridors
+/// </summary>
+/// <param name="markField">maze with the markings and their values</param>
+/// <param name="currentCoord">Coordination to get present position</param>
+/// <param name="latestCoord">Coordination to compare with possible next step</param>
+/// <returns>Coordination with the next step to get back to source - returns latest coordination if something went wrong</returns>
+static COORD POLICY_FUNCTION(policyNextStepBack)(element** markField, COORD currentCoord, COORD latestCoord)
+{
+	for (int rank = 0; rank < 4; rank++)
+	{
+		COORD offset = directionOffsets[POLICY_FUNCTION(policyOrder)[rank]];
+		COORD nextCoord = { currentCoord.X + offset.X, currentCoord.Y + offset.Y };
+		element next = markField[nextCoord.Y][nextCoord.X];
+
+		if ((nextCoord.X != latestCoord.X || nextCoord.Y != latestCoord.Y)
+			&& next.type == Marker && next.markOne == TRUE && next.markTwo == FALSE)
+			return nextCoord;
+	}
+
+	for (int rank = 0; rank < 4; rank++)
+	{
+		COORD offset = directionOffsets[POLICY_FUNCTION(policyOrder)[rank]];
+		COORD nextCoord = { currentCoord.X + offset.X, currentCoord.Y + offset.Y };
+
+		if ((nextCoord.X != latestCoord.X || nextCoord.Y != latestCoord.Y)
+			&& markField[nextCoord.Y][nextCoord.X].type == Corridor)
+			return nextCoord;
+	}
+
+	return latestCoord;
+}
+
+// The solver with all elements classified before and the one which classifies them on demand
+#define POLICY_ON_DEMAND FALSE
+#include "TremauxSolve.h"
+
+#define POLICY_ON_DEMAND TRUE
+#include "TremauxSolve.h"
+
+#undef POLICY_FUNCTION
+#undef POLICY_EXPAND
+#undef POLICY_JOIN
+#undef POLICY_NAME
+#undef POLICY_ORDER
+#undef POLICY_TIE_LAST
+#undef POLICY_LIMIT
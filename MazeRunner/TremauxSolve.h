@@ -0,0 +1,149 @@
+/*
+* Solve loop of one Trmaux' solver policy, TremauxPolicy.h includes this file twice for every policy.
+* Before including define:
+*
+*	POLICY_ON_DEMAND	TRUE to classify the neighbours before every step, for the content of getMazeContentOnDemand()
+*
+* With FALSE all elements are classified before, so the step loops have no classification left at all.
+*/
+
+#if POLICY_ON_DEMAND
+#define POLICY_SOLVE POLICY_FUNCTION(tremauxOnDemand)
+#else
+#define POLICY_SOLVE POLICY_FUNCTION(tremaux)
+#endif
+
+/// <summary>
+/// Solve the maze with the Trmaux' rules of the policy and count the shortest way back, without any console output
+/// </summary>
+/// <param name="elementField">content of the maze from getMazeContent(), with POLICY_ON_DEMAND from getMazeContentOnDemand(), the tags must be cleared</param>
+/// <param name="field">the scratch maze, to classify elements of the on-demand mode</param>
+/// <param name="dimension">of the maze in coordination</param>
+/// <param name="startPosition">the source position</param>
+/// <param name="path">receives the shortest way from source to destination, can be NULL</param>
+/// <param name="checkpoint">written periodically while searching the destination and continued when resumed, can be NULL</param>
+/// <returns>Status and the counted steps</returns>
+solveResult POLICY_SOLVE(element** elementField, char** field, COORD dimension, COORD startPosition, packedPath* path, solveCheckpoint* checkpoint)
+{
+	solveResult result = { 0 };
+	long long stepLimit = (long long)dimension.X * dimension.Y * SOLVER_STEP_LIMIT_FACTOR;
+
+	COORD latestCoord = { 0 };
+	COORD currentCoord = startPosition;
+	COORD nextCoord = startPosition;
+
+	// A resumed solve continues at the positions and with the steps of the checkpoint, its tags are already set
+	if (checkpoint != NULL && checkpoint->isResumed)
+	{
+		nextCoord = checkpoint->currentCoord;
+		latestCoord = checkpoint->latestCoord;
+		result.steps = checkpoint->steps;
+	}
+
+	INSTR_PHASE_BEGIN(PhaseSolve);
+
+#if POLICY_ON_DEMAND
+	// The rules only look at the neighbours, so they are classified before every step
+	classifyNeighbours(elementField, field, dimension, nextCoord);
+#endif
+
+	while (elementField[nextCoord.Y][nextCoord.X].type != Destination)
+	{
+		currentCoord = nextCoord;
+#if POLICY_ON_DEMAND
+		classifyNeighbours(elementField, field, dimension, currentCoord);
+#endif
+		nextCoord = POLICY_FUNCTION(policyFirstRule)(elementField, currentCoord, latestCoord);
+		INSTR_COUNT(steps);
+		INSTR_DIRECTION(currentCoord, nextCoord);
+
+		if (nextCoord.X == 0 && nextCoord.Y == 0)
+		{
+			INSTR_PHASE_END(PhaseSolve);
+			result.status = SolveNoSolution;
+			return result;
+		}
+
+		latestCoord = currentCoord;
+		result.steps++;
+
+		if (elementField[currentCoord.Y][currentCoord.X].type == Marker)
+		{
+			if (elementField[currentCoord.Y][currentCoord.X].markOne == FALSE)
+			{
+				elementField[currentCoord.Y][currentCoord.X].markOne = TRUE;
+				INSTR_COUNT(markOneTags);
+
+				if (checkpoint != NULL)
+					markCheckpoint(checkpoint, 0, dimension, currentCoord);
+			}
+			else if (elementField[currentCoord.Y][currentCoord.X].markTwo == FALSE)
+			{
+				elementField[currentCoord.Y][currentCoord.X].markTwo = TRUE;
+				INSTR_COUNT(markTwoTags);
+
+				if (checkpoint != NULL)
+					markCheckpoint(checkpoint, 1, dimension, currentCoord);
+			}
+		}
+
+		if (result.steps > stepLimit)
+		{
+			INSTR_PHASE_END(PhaseSolve);
+			result.status = SolveStepLimit;
+			return result;
+		}
+
+		if (checkpoint != NULL && result.steps >= checkpoint->nextSteps)
+			saveCheckpoint(checkpoint, dimension, startPosition, nextCoord, latestCoord, result.steps);
+	}
+
+	INSTR_PHASE_END(PhaseSolve);
+	INSTR_PHASE_BEGIN(PhasePath);
+
+	result.destination = nextCoord;
+
+	// Count the way back to the source
+	latestCoord.X = 0;
+	latestCoord.Y = 0;
+
+	if (path != NULL)
+		path->length = 0;
+
+	while (nextCoord.X != startPosition.X || nextCoord.Y != startPosition.Y)
+	{
+		currentCoord = nextCoord;
+#if POLICY_ON_DEMAND
+		classifyNeighbours(elementField, field, dimension, currentCoord);
+#endif
+		nextCoord = POLICY_FUNCTION(policyNextStepBack)(elementField, currentCoord, latestCoord);
+
+		if ((nextCoord.X == latestCoord.X && nextCoord.Y == latestCoord.Y) || result.stepsBack > stepLimit)
+		{
+			INSTR_PHASE_END(PhasePath);
+			result.status = SolveNoWayBack;
+			return result;
+		}
+
+		if (path != NULL)
+			appendPathMove(path, getDirection(currentCoord, nextCoord));
+
+		// The way enters every cell of the way back except the source
+		result.cost += elementField[currentCoord.Y][currentCoord.X].cost;
+		latestCoord = currentCoord;
+		result.stepsBack++;
+		INSTR_COUNT(wayBackSteps);
+	}
+
+	// The way was recorded backwards from the destination
+	if (path != NULL)
+		reversePath(path, startPosition, directionOpposite);
+
+	INSTR_PHASE_END(PhasePath);
+
+	result.status = SolveFound;
+	return result;
+}
+
+#undef POLICY_SOLVE
+#undef POLICY_ON_DEMAND